@@ -0,0 +1,313 @@
+/**
+ * @file MailBoxMemoryBench.c
+ * @author vishal k
+ * @brief Benchmark of @ref MailBoxMemory.h with a large set of mailboxes
+ * @date 2021-03-06
+ * 
+ * Usage: memory_bench [mailboxes] [operations]
+ * 
+ * Adds to and views randomly chosen mailboxes, first with every mailbox allocated by malloc, then from
+ * the backing memory provider on regular pages and on huge pages. Prints latency per operation and data
+ * TLB read misses per operation. Misses show n/a where perf events are not permitted, see
+ * /proc/sys/kernel/perf_event_paranoid.
+ * 
+ * Then fills a @ref MailBoxChunked.h mailbox to @ref MAILBOX_CHUNKED_MAX_MAILS and compares it with a list
+ * holding one message per node: bytes per message, links in the list and the cost of reaching a random
+ * index. The chunked mailbox is measured full and again after every other message was deleted.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "UsrConfig.h"
+#include "MailBoxMemory.h"
+#include "MailBoxClock.h"
+#include "MailBoxChunked.h"
+#ifdef USE_STATIC_MAILBOX
+#include "MailBoxStatic.h"
+typedef sMailBox_t BenchBox_t;
+#define BenchBoxInit      MailboxStaticInit
+#define BenchBoxAddMail   MailboxStaticAddMail
+#define BenchBoxview      MailboxStaticview
+#else
+#include "MailBoxDynamic.h"
+typedef sMailBoxDynamic_t BenchBox_t;
+#define BenchBoxInit      MailboxDynamicInit
+#define BenchBoxAddMail   MailboxDynamicAddMail
+#define BenchBoxview      MailboxDynamicview
+#endif
+
+/**
+ * @brief Where the mailboxes of a run live
+ * 
+ */
+typedef enum
+{
+    E_BENCH_MALLOC = 0,         /**< One malloc per mailbox and per node*/
+    E_BENCH_PROVIDER,           /**< Provider on regular pages*/
+    E_BENCH_PROVIDER_HUGE       /**< Provider on huge pages*/
+}eBenchBacking_t;
+
+/**
+ * @brief Node of a list with one message per node, the smallest node the dynamic mailbox layout allows
+ * 
+ */
+typedef struct sBenchNode_t
+{
+    struct sBenchNode_t* next;
+    char Msg[MAX_MSG_SIZE];
+}sBenchNode_t;
+
+/**
+ * @brief Helper function to open a data TLB read miss counter for the calling thread
+ * 
+ * @return int descriptor, -1 if not permitted
+ */
+static int BenchTlbOpen()
+{
+    struct perf_event_attr attr ;
+
+    memset(&attr , 0 , sizeof(attr));
+    attr.size = sizeof(attr) ;
+    attr.type = PERF_TYPE_HW_CACHE ;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) ;
+    attr.disabled = 1 ;
+    attr.exclude_kernel = 1 ;
+    attr.exclude_hv = 1 ;
+
+    return (int)syscall(SYS_perf_event_open , &attr , 0 , -1 , -1 , 0);
+}
+
+/**
+ * @brief Helper function, xorshift random numbers so the generator stays out of the measurement
+ * 
+ * @param pState generator state, not 0
+ * @return uint32_t next number
+ */
+static uint32_t BenchRandom(uint32_t* const pState)
+{
+    uint32_t x = *pState ;
+
+    x ^= x << 13 ;
+    x ^= x >> 17 ;
+    x ^= x << 5 ;
+    *pState = x ;
+
+    return x;
+}
+
+/**
+ * @brief Run one configuration
+ * 
+ * @param backing @ref eBenchBacking_t
+ * @param boxNum mailboxes
+ * @param ops add and view pairs
+ */
+static void BenchRun(eBenchBacking_t backing , size_t boxNum , size_t ops)
+{
+    static const char* const names[] = { "malloc" , "provider 4K" , "provider 2M" } ;
+    sMailMemory_t memory ;
+    BenchBox_t** pBoxes = (BenchBox_t**)malloc(boxNum * sizeof(BenchBox_t*)) ;
+    char msg[MAX_MSG_SIZE] ;
+
+    MailboxMemoryInit(&memory , 64 * MAIL_HUGE_PAGE_SIZE , E_MEM_NUMA_LOCAL | ((E_BENCH_PROVIDER_HUGE == backing) ? E_MEM_HUGEPAGE : 0));
+    memset(msg , 0 , sizeof(msg));
+
+    for(size_t i = 0 ; i < boxNum ; i++)
+    {
+        pBoxes[i] = (E_BENCH_MALLOC == backing) ? (BenchBox_t*)malloc(sizeof(BenchBox_t))
+                                                : (BenchBox_t*)MailboxMemoryAlloc(&memory , sizeof(BenchBox_t)) ;
+        BenchBoxInit(pBoxes[i]);
+        #ifdef USE_DYNAMIC_MAILBOX
+        MailboxDynamicSetMemory(pBoxes[i] , (E_BENCH_MALLOC == backing) ? NULL : &memory);
+        #endif
+    }
+
+    /// Fill every mailbox so nodes exist before the measurement
+    for(size_t i = 0 ; i < boxNum ; i++)
+    {
+        for(size_t j = 0 ; j < MAX_MAILS ; j++)
+        {
+            BenchBoxAddMail(pBoxes[i] , msg);
+        }
+    }
+
+    int fd = BenchTlbOpen() ;
+    uint32_t state = 2463534242u ;
+    uint64_t sum = 0 ;
+
+    if(-1 != fd)
+    {
+        ioctl(fd , PERF_EVENT_IOC_RESET , 0);
+        ioctl(fd , PERF_EVENT_IOC_ENABLE , 0);
+    }
+
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < ops ; i++)
+    {
+        BenchBox_t* pBox = pBoxes[BenchRandom(&state) % boxNum] ;
+
+        memcpy(msg , &i , sizeof(i));
+        BenchBoxAddMail(pBox , msg);
+        BenchBoxview(pBox , msg);
+        sum += (uint8_t)msg[0] ;
+    }
+
+    uint64_t elapsed = MailboxClockNow() - start ;
+    uint64_t misses = 0 ;
+
+    if(-1 != fd)
+    {
+        ioctl(fd , PERF_EVENT_IOC_DISABLE , 0);
+        if(sizeof(misses) != read(fd , &misses , sizeof(misses)))
+        {
+            misses = 0 ;
+        }
+        close(fd);
+    }
+
+    printf("%-12s %8.1f ns/op  " , names[backing] , (double)elapsed / (double)ops);
+    if(-1 != fd)
+    {
+        printf("%8.3f dTLB misses/op" , (double)misses / (double)ops);
+    }
+    else
+    {
+        printf("%8s dTLB misses/op" , "n/a");
+    }
+    printf("  (hugetlb %zu , thp %zu , small %zu , numa %zu regions , checksum %llu)\n" , memory.HugeTlbRegions ,
+           memory.ThpRegions , memory.SmallRegions , memory.NumaRegions , (unsigned long long)sum);
+
+    if(E_BENCH_MALLOC == backing)
+    {
+        /// Nodes of the dynamic mailbox are never freed, the malloc run leaks them on purpose
+        for(size_t i = 0 ; i < boxNum ; i++)
+        {
+            free(pBoxes[i]);
+        }
+    }
+    MailboxMemoryDeinit(&memory);
+    free(pBoxes);
+}
+
+/**
+ * @brief Helper function, average time to reach a random index of the chunked mailbox and print the line
+ * 
+ * @param name label of the line
+ * @param pBox filled chunked mailbox
+ * @param ops lookups
+ */
+static void BenchChunkedLookup(const char* const name , sMailBoxChunked_t* const pBox , size_t ops)
+{
+    char msg[MAX_MSG_SIZE] ;
+    uint32_t state = 2463534242u ;
+    uint64_t sum = 0 ;
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < ops ; i++)
+    {
+        MailboxChunkedViewAt(pBox , BenchRandom(&state) % pBox->ActiveMsgNum , msg);
+        sum += (uint8_t)msg[0] ;
+    }
+
+    uint64_t elapsed = MailboxClockNow() - start ;
+
+    printf("%-18s %6zu msgs %6zu links %6.1f bytes/msg %10.1f ns/lookup  (checksum %llu)\n" , name , pBox->ActiveMsgNum ,
+           pBox->ChunkNum , (double)(pBox->ChunkNum * sizeof(sMailChunk_t)) / (double)pBox->ActiveMsgNum ,
+           (double)elapsed / (double)ops , (unsigned long long)sum);
+}
+
+/**
+ * @brief Compare the chunked mailbox with a list of one message per node at @ref MAILBOX_CHUNKED_MAX_MAILS depth
+ * 
+ * @param ops random lookups per configuration
+ */
+static void BenchChunked(size_t ops)
+{
+    const size_t depth = MAILBOX_CHUNKED_MAX_MAILS ;
+    sMailBoxChunked_t box ;
+    sBenchNode_t* head = NULL ;
+    sBenchNode_t** ppLink = &head ;
+    char msg[MAX_MSG_SIZE] ;
+
+    memset(msg , 0 , sizeof(msg));
+    MailboxChunkedInit(&box);
+
+    for(size_t i = 0 ; i < depth ; i++)
+    {
+        sBenchNode_t* pNode = (sBenchNode_t*)malloc(sizeof(sBenchNode_t)) ;
+
+        if(NULL == pNode)
+        {
+            break;
+        }
+        memcpy(msg , &i , sizeof(i));
+        memcpy(pNode->Msg , msg , MAX_MSG_SIZE);
+        pNode->next = NULL ;
+        *ppLink = pNode ;
+        ppLink = &pNode->next ;
+        MailboxChunkedAddMail(&box , msg);
+    }
+
+    /// Same random indices as the chunked runs
+    uint32_t state = 2463534242u ;
+    uint64_t sum = 0 ;
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < ops ; i++)
+    {
+        sBenchNode_t const* pNode = head ;
+
+        for(size_t hop = BenchRandom(&state) % depth ; 0 != hop ; hop--)
+        {
+            pNode = pNode->next ;
+        }
+        sum += (uint8_t)pNode->Msg[0] ;
+    }
+
+    uint64_t elapsed = MailboxClockNow() - start ;
+
+    printf("\nchunked mailbox , %zu messages per chunk of %zu bytes\n" , MAIL_CHUNK_MSGS , sizeof(sMailChunk_t));
+    printf("%-18s %6zu msgs %6zu links %6.1f bytes/msg %10.1f ns/lookup  (checksum %llu)\n" , "node per message" , depth ,
+           depth , (double)sizeof(sBenchNode_t) , (double)elapsed / (double)ops , (unsigned long long)sum);
+    BenchChunkedLookup("chunked full" , &box , ops);
+
+    /// Delete every other message, merging keeps the inner chunks at least half full
+    box.CurMsgIndex = 0 ;
+    for(size_t i = 0 ; i < depth / 2 ; i++)
+    {
+        MailboxChunkedDeleteMail(&box);
+        MailboxChunkedScrollNext(&box);
+    }
+    BenchChunkedLookup("chunked thinned" , &box , ops);
+
+    while(NULL != head)
+    {
+        sBenchNode_t* pNode = head ;
+
+        head = head->next ;
+        free(pNode);
+    }
+    MailboxChunkedDeinit(&box);
+}
+
+int main(int argc , char** argv)
+{
+    size_t boxNum = (argc > 1) ? strtoul(argv[1] , NULL , 0) : 65536 ;
+    size_t ops = (argc > 2) ? strtoul(argv[2] , NULL , 0) : 4000000 ;
+
+    printf("mailboxes %zu of %zu bytes , operations %zu\n" , boxNum , sizeof(BenchBox_t) , ops);
+
+    BenchRun(E_BENCH_MALLOC , boxNum , ops);
+    BenchRun(E_BENCH_PROVIDER , boxNum , ops);
+    BenchRun(E_BENCH_PROVIDER_HUGE , boxNum , ops);
+    BenchChunked(ops / 40);
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file MailBoxShardBench.c
+ * @author vishal k
+ * @brief Multi threaded throughput benchmark of @ref MailBoxShard.h
+ * @date 2021-03-06
+ * 
+ * Usage: shard_bench [threads] [messages per producer]
+ * 
+ * Runs the given number of producer and consumer threads against a mailbox with a single shard and
+ * against one with a shard per cpu, and prints the throughput of both.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "MailBoxShard.h"
+#include "MailBoxClock.h"
+
+static sMailShardBox_t gShardBox;                   /**< Mailbox under test*/
+static size_t gPerProducer = 0 ;                    /**< Messages posted by each producer*/
+static size_t gTotal = 0 ;                          /**< Messages posted by all producers*/
+static size_t gTaken = 0 ;                          /**< Messages taken by all consumers so far*/
+
+/**
+ * @brief Producer thread, posts numbered messages and retries while its shard is full
+ * 
+ * @param arg producer id
+ * @return void* unused
+ */
+static void* BenchProducer(void* arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg ;
+    char msg[MAX_MSG_SIZE] ;
+
+    memset(msg , 0 , sizeof(msg));
+
+    for(uint32_t i = 0 ; i < gPerProducer ; i++)
+    {
+        memcpy(&msg[0] , &id , sizeof(id));
+        memcpy(&msg[4] , &i , sizeof(i));
+
+        while(E_MAILBOXFULL == MailboxShardPost(&gShardBox , msg))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread, takes messages until every posted message was taken
+ * 
+ * @param arg unused
+ * @return void* unused
+ */
+static void* BenchConsumer(void* arg)
+{
+    (void)arg;
+    char msg[MAX_MSG_SIZE] ;
+
+    while(__atomic_load_n(&gTaken , __ATOMIC_RELAXED) < gTotal)
+    {
+        if(E_NOERROR == MailboxShardReceive(&gShardBox , msg))
+        {
+            __atomic_fetch_add(&gTaken , 1 , __ATOMIC_RELAXED);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run one configuration
+ * 
+ * @param threads producer threads, the same number of consumers is started
+ * @param shards shard count, 0 for one per cpu
+ * @param pShardNum will be updated with the shard count actually used
+ * @return double messages per second
+ */
+static double BenchRun(size_t threads , size_t shards , size_t* const pShardNum)
+{
+    pthread_t* pThreads = (pthread_t*)malloc(2 * threads * sizeof(pthread_t)) ;
+
+    MailboxShardInit(&gShardBox , shards);
+    gTotal = threads * gPerProducer ;
+    gTaken = 0 ;
+
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < threads ; i++)
+    {
+        pthread_create(&pThreads[i] , NULL , BenchProducer , (void*)(uintptr_t)i);
+        pthread_create(&pThreads[threads + i] , NULL , BenchConsumer , NULL);
+    }
+
+    for(size_t i = 0 ; i < 2 * threads ; i++)
+    {
+        pthread_join(pThreads[i] , NULL);
+    }
+
+    uint64_t elapsed = MailboxClockNow() - start ;
+
+    *pShardNum = gShardBox.ShardNum ;
+    MailboxShardDeinit(&gShardBox);
+    free(pThreads);
+
+    return (double)gTotal * 1e9 / (double)elapsed ;
+}
+
+int main(int argc , char** argv)
+{
+    size_t threads = (argc > 1) ? strtoul(argv[1] , NULL , 0) : 4 ;
+    gPerProducer = (argc > 2) ? strtoul(argv[2] , NULL , 0) : 200000 ;
+
+    size_t shardNum = 0 ;
+    double single = BenchRun(threads , 1 , &shardNum) ;
+    double sharded = BenchRun(threads , 0 , &shardNum) ;
+
+    printf("threads %zu , messages %zu , shards %zu\n" , threads , threads * gPerProducer , shardNum);
+    printf("single shard   %12.0f msg/s\n" , single);
+    printf("per cpu shards %12.0f msg/s (x%.2f)\n" , sharded , sharded / single);
+
+    return 0;
+}
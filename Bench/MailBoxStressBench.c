@@ -0,0 +1,440 @@
+/**
+ * @file MailBoxStressBench.c
+ * @author vishal k
+ * @brief Multi threaded contention benchmark and correctness checker
+ * @date 2021-03-06
+ * 
+ * Usage: stress_bench [max threads] [messages per producer]
+ * 
+ * Runs 1, 2, 4 ... max threads producers and as many consumers against one mailbox and prints one CSV line
+ * per run. Variants:
+ * - drop  : mailbox behind a mutex, full mailbox drops the oldest message
+ * - block : mailbox behind a mutex, full mailbox blocks the producer, see @ref E_OVERFLOW_BLOCK
+ * - shard : @ref MailBoxShard.h with one shard per producer, a full shard is retried
+ * 
+ * Every message carries its producer and a per producer sequence number. Consumers check that no message
+ * arrives twice and that each consumer sees the messages of a producer in increasing order. Messages not
+ * received must all be accounted for by @ref E_MAILBOXOVERWRITTEN returns, the check column is ok only then.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "UsrConfig.h"
+#include "MailBoxShard.h"
+#include "MailBoxClock.h"
+#ifdef USE_STATIC_MAILBOX
+#include "MailBoxStatic.h"
+typedef sMailBox_t BenchBox_t;
+#define BenchBoxInit                MailboxStaticInit
+#define BenchBoxDeinit              MailboxStaticDeinit
+#define BenchBoxAddMail             MailboxStaticAddMail
+#define BenchBoxReceive             MailboxStaticReceive
+#define BenchBoxSetOverflowPolicy   MailboxStaticSetOverflowPolicy
+#else
+#include "MailBoxDynamic.h"
+typedef sMailBoxDynamic_t BenchBox_t;
+#define BenchBoxInit                MailboxDynamicInit
+#define BenchBoxDeinit              MailboxDynamicDeinit
+#define BenchBoxAddMail             MailboxDynamicAddMail
+#define BenchBoxReceive             MailboxDynamicReceive
+#define BenchBoxSetOverflowPolicy   MailboxDynamicSetOverflowPolicy
+#endif
+
+static const size_t MAX_BENCH_THREADS = 64 ;    //> Max producers, the same number of consumers is started
+
+/**
+ * @brief Mailbox variants under test
+ * 
+ */
+typedef enum
+{
+    E_BENCH_DROP = 0,
+    E_BENCH_BLOCK,
+    E_BENCH_SHARD
+}eBenchVariant_t;
+
+/**
+ * @brief Per thread results
+ * 
+ */
+typedef struct
+{
+    uint32_t Id;
+    uint32_t* Latency;          /**< Producer, duration of each add in nanoseconds*/
+    size_t LatencyNum;
+    size_t Overwritten;         /**< Producer, adds that dropped the oldest message*/
+    size_t Received;            /**< Consumer, messages taken*/
+    size_t Duplicates;          /**< Consumer, messages seen before*/
+    size_t OrderErrors;         /**< Consumer, messages older than the last one taken from the same producer*/
+    uint32_t* LastSeq;          /**< Consumer, last sequence number plus one taken from each producer*/
+}__attribute__((aligned(64))) sBenchThread_t;
+
+static eBenchVariant_t gVariant;
+static BenchBox_t gBox;
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER ;
+static sMailShardBox_t gShardBox;
+static size_t gProducers = 0 ;
+static size_t gPerProducer = 0 ;
+static size_t gProducersDone = 0 ;
+static uint8_t* gSeen = NULL ;                  /**< One flag per message, set by the consumer that takes it*/
+static uint32_t* gReceiveLatency = NULL ;       /**< Duration of each receive in nanoseconds, shared by the consumers*/
+static size_t gReceiveNum = 0 ;                 /**< Next free entry of @ref gReceiveLatency , may run past the messages*/
+
+/**
+ * @brief Helper function that adds one message to the mailbox under test
+ * 
+ * @param id producer id
+ * @param msg message
+ * @return eMailStatus_t status of the add
+ */
+static eMailStatus_t BenchAdd(uint32_t id , const char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    if(E_BENCH_SHARD == gVariant)
+    {
+        while(E_MAILBOXFULL == (status = MailboxShardPostTo(&gShardBox , id % gShardBox.ShardNum , msg)))
+        {
+            sched_yield();
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&gLock);
+        status = BenchBoxAddMail(&gBox , msg) ;
+        pthread_mutex_unlock(&gLock);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Helper function that takes the oldest message from the mailbox under test
+ * 
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there was nothing to take
+ */
+static eMailStatus_t BenchReceive(char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    if(E_BENCH_SHARD == gVariant)
+    {
+        status = MailboxShardReceive(&gShardBox , msg) ;
+    }
+    else
+    {
+        pthread_mutex_lock(&gLock);
+        status = BenchBoxReceive(&gBox , msg) ;
+        pthread_mutex_unlock(&gLock);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Producer thread, adds numbered messages
+ * 
+ * @param arg @ref sBenchThread_t
+ * @return void* unused
+ */
+static void* BenchProducer(void* arg)
+{
+    sBenchThread_t* pThread = (sBenchThread_t*)arg ;
+    char msg[MAX_MSG_SIZE] ;
+
+    memset(msg , 0 , sizeof(msg));
+
+    for(uint32_t seq = 0 ; seq < gPerProducer ; seq++)
+    {
+        memcpy(&msg[0] , &pThread->Id , sizeof(pThread->Id));
+        memcpy(&msg[4] , &seq , sizeof(seq));
+
+        uint64_t start = MailboxClockNow() ;
+        eMailStatus_t status = BenchAdd(pThread->Id , msg) ;
+        pThread->Latency[pThread->LatencyNum++] = (uint32_t)(MailboxClockNow() - start) ;
+
+        if(E_MAILBOXOVERWRITTEN == status)
+        {
+            pThread->Overwritten++ ;
+        }
+    }
+
+    __atomic_fetch_add(&gProducersDone , 1 , __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread, takes messages until the producers are done and the mailbox is empty
+ * 
+ * @param arg @ref sBenchThread_t
+ * @return void* unused
+ */
+static void* BenchConsumer(void* arg)
+{
+    sBenchThread_t* pThread = (sBenchThread_t*)arg ;
+    char msg[MAX_MSG_SIZE] ;
+
+    while(true)
+    {
+        /// Read before the receive, an empty mailbox after all producers finished stays empty
+        bool done = (gProducers == __atomic_load_n(&gProducersDone , __ATOMIC_ACQUIRE)) ;
+        uint64_t start = MailboxClockNow() ;
+        eMailStatus_t status = BenchReceive(msg) ;
+        uint64_t elapsed = MailboxClockNow() - start ;
+
+        if(E_MAILBOXEMPTY == status)
+        {
+            if(true == done)
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        uint32_t id = 0 ;
+        uint32_t seq = 0 ;
+
+        memcpy(&id , &msg[0] , sizeof(id));
+        memcpy(&seq , &msg[4] , sizeof(seq));
+
+        /// Duplicates can take more receives than there are messages, their samples are dropped
+        size_t sample = __atomic_fetch_add(&gReceiveNum , 1 , __ATOMIC_RELAXED) ;
+
+        if(sample < gProducers * gPerProducer)
+        {
+            gReceiveLatency[sample] = (uint32_t)elapsed ;
+        }
+        pThread->Received++ ;
+
+        if( (id >= gProducers) || (seq >= gPerProducer) ||
+            (0 != __atomic_exchange_n(&gSeen[id * gPerProducer + seq] , 1 , __ATOMIC_RELAXED)) )
+        {
+            pThread->Duplicates++ ;
+            continue;
+        }
+
+        if(seq < pThread->LastSeq[id])
+        {
+            pThread->OrderErrors++ ;
+        }
+        pThread->LastSeq[id] = seq + 1 ;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for qsort, ascending latencies
+ * 
+ */
+static int BenchCompare(const void* a , const void* b)
+{
+    uint32_t x = *(const uint32_t*)a ;
+    uint32_t y = *(const uint32_t*)b ;
+
+    return (x > y) - (x < y) ;
+}
+
+/**
+ * @brief Helper function that gathers the add latencies of the producers and sorts them
+ * 
+ * @param threads producer threads
+ * @param num number of threads
+ * @param pAll scratch array that receives every sample, sorted
+ * @param pNum will be updated with the number of samples
+ */
+static void BenchMerge(sBenchThread_t const* const threads , size_t num , uint32_t* const pAll , size_t* const pNum)
+{
+    size_t total = 0 ;
+
+    for(size_t i = 0 ; i < num ; i++)
+    {
+        memcpy(&pAll[total] , threads[i].Latency , threads[i].LatencyNum * sizeof(uint32_t));
+        total += threads[i].LatencyNum ;
+    }
+    qsort(pAll , total , sizeof(uint32_t) , BenchCompare);
+    *pNum = total ;
+}
+
+/**
+ * @brief Helper function, percentile of sorted samples
+ * 
+ * @param all sorted samples
+ * @param num number of samples
+ * @param permille percentile times ten
+ * @return uint32_t sample at the percentile , 0 without samples
+ */
+static uint32_t BenchPercentile(uint32_t const* const all , size_t num , size_t permille)
+{
+    return (0 == num) ? 0 : all[(num - 1) * permille / 1000] ;
+}
+
+/**
+ * @brief Helper function that frees the buffers of a run
+ * 
+ * @param pThreads threads, may be NULL
+ * @param num number of threads
+ */
+static void BenchFree(sBenchThread_t* const pThreads , size_t num)
+{
+    for(size_t i = 0 ; (NULL != pThreads) && (i < num) ; i++)
+    {
+        free(pThreads[i].Latency);
+        free(pThreads[i].LastSeq);
+    }
+    free(pThreads);
+    free(gSeen);
+    free(gReceiveLatency);
+    gSeen = NULL ;
+    gReceiveLatency = NULL ;
+}
+
+/**
+ * @brief Run one configuration and print its CSV line
+ * 
+ * @param variant @ref eBenchVariant_t
+ * @param threads number of producers, the same number of consumers is started
+ * @return false if the buffers of the run could not be allocated
+ */
+static bool BenchRun(eBenchVariant_t variant , size_t threads)
+{
+    static const char* const names[] = { "drop" , "block" , "shard" } ;
+    size_t total = threads * gPerProducer ;
+    sBenchThread_t* pThreads = (sBenchThread_t*)aligned_alloc(64 , 2 * threads * sizeof(sBenchThread_t)) ;
+    pthread_t* pHandles = (pthread_t*)malloc(2 * threads * sizeof(pthread_t)) ;
+    uint32_t* pAll = (uint32_t*)malloc(total * sizeof(uint32_t)) ;
+    bool allocated = (NULL != pThreads) && (NULL != pHandles) && (NULL != pAll) ;
+
+    gVariant = variant ;
+    gProducers = threads ;
+    gProducersDone = 0 ;
+    gReceiveNum = 0 ;
+    gSeen = (uint8_t*)calloc(total , 1) ;
+    gReceiveLatency = (uint32_t*)malloc(total * sizeof(uint32_t)) ;
+    allocated = allocated && (NULL != gSeen) && (NULL != gReceiveLatency) ;
+
+    /// Only producers keep their own samples, consumers share @ref gReceiveLatency
+    for(size_t i = 0 ; (NULL != pThreads) && (i < 2 * threads) ; i++)
+    {
+        memset(&pThreads[i] , 0 , sizeof(sBenchThread_t));
+        pThreads[i].Id = (uint32_t)((i < threads) ? i : (i - threads)) ;
+        pThreads[i].Latency = (i < threads) ? (uint32_t*)malloc(gPerProducer * sizeof(uint32_t)) : NULL ;
+        pThreads[i].LastSeq = (uint32_t*)calloc(threads , sizeof(uint32_t)) ;
+        allocated = allocated && ((i >= threads) || (NULL != pThreads[i].Latency)) && (NULL != pThreads[i].LastSeq) ;
+    }
+
+    if(false == allocated)
+    {
+        fprintf(stderr , "stress_bench: out of memory for %zu threads and %zu messages\n" , threads , total);
+        BenchFree(pThreads , (NULL != pThreads) ? (2 * threads) : 0);
+        free(pAll);
+        free(pHandles);
+        return false;
+    }
+
+    /// Only the mailbox of the variant is set up, each run tears it down again
+    if(E_BENCH_SHARD == variant)
+    {
+        MailboxShardInit(&gShardBox , threads);
+    }
+    else
+    {
+        BenchBoxInit(&gBox);
+        if(E_BENCH_BLOCK == variant)
+        {
+            BenchBoxSetOverflowPolicy(&gBox , E_OVERFLOW_BLOCK , MAIL_WAIT_FOREVER , &gLock);
+        }
+    }
+
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < threads ; i++)
+    {
+        pthread_create(&pHandles[i] , NULL , BenchProducer , &pThreads[i]);
+        pthread_create(&pHandles[threads + i] , NULL , BenchConsumer , &pThreads[threads + i]);
+    }
+
+    for(size_t i = 0 ; i < 2 * threads ; i++)
+    {
+        pthread_join(pHandles[i] , NULL);
+    }
+
+    double seconds = (double)(MailboxClockNow() - start) / 1e9 ;
+    size_t overwritten = 0 ;
+    size_t received = 0 ;
+    size_t duplicates = 0 ;
+    size_t orderErrors = 0 ;
+
+    for(size_t i = 0 ; i < threads ; i++)
+    {
+        overwritten += pThreads[i].Overwritten ;
+        received += pThreads[threads + i].Received ;
+        duplicates += pThreads[threads + i].Duplicates ;
+        orderErrors += pThreads[threads + i].OrderErrors ;
+    }
+
+    size_t lost = total - (received - duplicates) ;
+    size_t addNum = 0 ;
+    size_t receiveNum = 0 ;
+    uint32_t addP50 , addP99 , addP999 , receiveP99 ;
+
+    BenchMerge(pThreads , threads , pAll , &addNum);
+    addP50 = BenchPercentile(pAll , addNum , 500) ;
+    addP99 = BenchPercentile(pAll , addNum , 990) ;
+    addP999 = BenchPercentile(pAll , addNum , 999) ;
+    receiveNum = (gReceiveNum < total) ? gReceiveNum : total ;
+    qsort(gReceiveLatency , receiveNum , sizeof(uint32_t) , BenchCompare);
+    receiveP99 = BenchPercentile(gReceiveLatency , receiveNum , 990) ;
+
+    bool ok = (0 == duplicates) && (0 == orderErrors) && (lost == overwritten) ;
+
+    printf("%s,%zu,%zu,%zu,%.4f,%.0f,%u,%u,%u,%u,%zu,%zu,%zu,%zu,%s\n" , names[variant] , threads , threads , total ,
+           seconds , (double)total / seconds , addP50 , addP99 , addP999 , receiveP99 , overwritten , lost ,
+           duplicates , orderErrors , (true == ok) ? "ok" : "FAIL");
+    fflush(stdout);
+
+    if(E_BENCH_SHARD == variant)
+    {
+        MailboxShardDeinit(&gShardBox);
+    }
+    else
+    {
+        BenchBoxDeinit(&gBox);
+    }
+    BenchFree(pThreads , 2 * threads);
+    free(pAll);
+    free(pHandles);
+
+    return true;
+}
+
+int main(int argc , char** argv)
+{
+    size_t maxThreads = (argc > 1) ? strtoul(argv[1] , NULL , 0) : 8 ;
+    gPerProducer = (argc > 2) ? strtoul(argv[2] , NULL , 0) : 100000 ;
+
+    maxThreads = (maxThreads < 1) ? 1 : ((maxThreads > MAX_BENCH_THREADS) ? MAX_BENCH_THREADS : maxThreads) ;
+
+    printf("variant,producers,consumers,messages,seconds,msg_per_s,add_p50_ns,add_p99_ns,add_p999_ns,"
+           "receive_p99_ns,overwritten,lost,duplicates,order_errors,check\n");
+
+    for(int variant = E_BENCH_DROP ; variant <= E_BENCH_SHARD ; variant++)
+    {
+        for(size_t threads = 1 ; threads <= maxThreads ; threads *= 2)
+        {
+            if(false == BenchRun((eBenchVariant_t)variant , threads))
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
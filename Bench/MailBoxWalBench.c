@@ -0,0 +1,150 @@
+/**
+ * @file MailBoxWalBench.c
+ * @author vishal k
+ * @brief Group commit benchmark and replay walk through of @ref MailBoxWal.h
+ * @date 2021-03-06
+ * 
+ * Usage: wal_bench [threads] [adds per thread] [max delay in microseconds] [log file]
+ * 
+ * Starts the given number of threads adding to one durable mailbox and prints the adds per sync the group
+ * commit reached. The log is then closed and replayed into a fresh mailbox, and finally compacted by hand.
+ * Every step prints the messages in the mailbox and the records in the log. The log file is removed at the end.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "UsrConfig.h"
+#include "MailBoxWal.h"
+#include "MailBoxClock.h"
+#ifdef USE_STATIC_MAILBOX
+#define BenchBoxInit                MailboxStaticInit
+#define BenchBoxDeinit              MailboxStaticDeinit
+#else
+#define BenchBoxInit                MailboxDynamicInit
+#define BenchBoxDeinit              MailboxDynamicDeinit
+#endif
+
+static const size_t MAX_BENCH_THREADS = 64 ;        //> Max adding threads
+static const size_t BENCH_COMPACT_AT = 1000000 ;    //> Log records that trigger compaction, high so only the forced one runs
+
+static sMailWalBox_t gBox;                      /**< Mailbox behind the log*/
+static sMailWal_t gWal;                         /**< Log under test*/
+static size_t gPerThread = 0 ;                  /**< Adds of each thread*/
+static size_t gErrors = 0 ;                     /**< Adds that could not be logged*/
+
+/**
+ * @brief Adding thread, posts numbered messages, each returns once it is on disk
+ * 
+ * @param arg thread id
+ * @return void* unused
+ */
+static void* BenchAdder(void* arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg ;
+    char msg[MAX_MSG_SIZE] ;
+
+    memset(msg , 0 , sizeof(msg));
+
+    for(uint32_t i = 0 ; i < gPerThread ; i++)
+    {
+        snprintf(msg , sizeof(msg) , "t%u-%u" , id , i);
+
+        if(E_LOGIOERROR == MailboxWalAddMail(&gWal , msg))
+        {
+            __atomic_fetch_add(&gErrors , 1 , __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function to print the messages of the mailbox, oldest first, and the size of the log
+ * 
+ * @param step name of the step
+ */
+static void BenchPrint(const char* const step)
+{
+    char msg[MAX_MSG_SIZE] ;
+
+    printf("%-10s log %8zu records , %zu messages:" , step , gWal.LogRecords , gBox.ActiveMsgNum);
+
+    /// view and scroll leave the mailbox as it is
+    for(size_t i = 0 ; i < gBox.ActiveMsgNum ; i++)
+    {
+        if(E_NOERROR == MailboxWalview(&gWal , msg))
+        {
+            printf(" %s" , msg);
+        }
+        MailboxWalScrollNext(&gWal);
+    }
+    printf("\n");
+}
+
+int main(int argc , char** argv)
+{
+    size_t threads = (argc > 1) ? strtoul(argv[1] , NULL , 0) : 8 ;
+    gPerThread = (argc > 2) ? strtoul(argv[2] , NULL , 0) : 500 ;
+    uint64_t maxDelay = ((argc > 3) ? strtoull(argv[3] , NULL , 0) : 200) * 1000U ;
+    const char* path = (argc > 4) ? argv[4] : "/tmp/mailbox_wal_bench.log" ;
+    pthread_t pThreads[MAX_BENCH_THREADS] ;
+
+    threads = (0 == threads) ? 1 : ((threads > MAX_BENCH_THREADS) ? MAX_BENCH_THREADS : threads) ;
+    unlink(path);
+
+    BenchBoxInit(&gBox);
+    if(E_NOERROR != MailboxWalOpen(&gWal , &gBox , path , maxDelay , threads , BENCH_COMPACT_AT))
+    {
+        printf("cannot open %s\n" , path);
+        return 1;
+    }
+
+    /// Concurrent adds, every thread waits for its own sync so the threads form the batches
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < threads ; i++)
+    {
+        pthread_create(&pThreads[i] , NULL , BenchAdder , (void*)(uintptr_t)i);
+    }
+    for(size_t i = 0 ; i < threads ; i++)
+    {
+        pthread_join(pThreads[i] , NULL);
+    }
+
+    uint64_t elapsed = MailboxClockNow() - start ;
+    size_t adds = threads * gPerThread ;
+
+    printf("threads %zu , adds %zu , max delay %llu us , errors %zu\n" , threads , adds ,
+           (unsigned long long)(maxDelay / 1000U) , gErrors);
+    printf("syncs %zu , %.1f adds/sync , %.0f adds/s\n" , gWal.Syncs , (double)adds / (double)((0 != gWal.Syncs) ? gWal.Syncs : 1) ,
+           (double)adds * 1e9 / (double)elapsed);
+    BenchPrint("written");
+    MailboxWalClose(&gWal);
+    BenchBoxDeinit(&gBox);
+
+    /// Replay into a fresh mailbox, the same messages come back in the same order
+    BenchBoxInit(&gBox);
+    start = MailboxClockNow() ;
+    if(E_NOERROR != MailboxWalOpen(&gWal , &gBox , path , maxDelay , threads , BENCH_COMPACT_AT))
+    {
+        printf("cannot reopen %s\n" , path);
+        return 1;
+    }
+    printf("replay %.2f ms\n" , (double)(MailboxClockNow() - start) / 1e6);
+    BenchPrint("replayed");
+
+    /// Forced compaction leaves one add record per message
+    eMailStatus_t status = MailboxWalCompact(&gWal) ;
+
+    printf("compact status %d , failed compactions %zu\n" , status , gWal.CompactFails);
+    BenchPrint("compacted");
+    MailboxWalClose(&gWal);
+    BenchBoxDeinit(&gBox);
+    unlink(path);
+
+    return ((0 == gErrors) && (E_NOERROR == status)) ? 0 : 1 ;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file MailBoxCoroExample.cpp
+ * @author vishal k
+ * @brief Example of @ref MailBoxCoro.hpp with a run queue executor
+ * @date 2021-03-06
+ * 
+ */
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+
+#include "MailBoxCoro.hpp"
+
+/**
+ * @brief Minimal fire and forget coroutine type
+ * 
+ */
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+ * @brief Executor that queues resumed coroutines and runs them from the event loop
+ * 
+ */
+class RunQueueExecutor final : public MailboxExecutor
+{
+public:
+    void post(std::coroutine_handle<> handle) override
+    {
+        Queue.push_back(handle);
+    }
+
+    void run()
+    {
+        while(false == Queue.empty())
+        {
+            std::coroutine_handle<> handle = Queue.front() ;
+
+            Queue.pop_front();
+            handle.resume();
+        }
+    }
+
+private:
+    std::deque<std::coroutine_handle<>> Queue;
+};
+
+/**
+ * @brief Consumer coroutine, prints the messages it receives
+ * 
+ */
+static Task Consumer(MailboxCoro& box , const char* name , int count)
+{
+    for(int i = 0 ; i < count ; i++)
+    {
+        sMailMsg_t msg = co_await box.receive() ;
+
+        printf("%s got %s\n" , name , msg.data());
+    }
+}
+
+int main()
+{
+    RunQueueExecutor executor ;
+    MailboxCoro box(executor) ;
+    char msg[MAX_MSG_SIZE] = "stored" ;
+
+    MailboxInit();
+
+    /// A message added before anyone waits is taken without suspending
+    MailboxAddMail(msg);
+    Consumer(box , "A" , 2);
+    Consumer(box , "B" , 2);
+
+    /// Both consumers wait now, messages are handed over directly
+    for(int i = 0 ; i < 2 ; i++)
+    {
+        snprintf(msg , sizeof(msg) , "sent %d" , i);
+        box.send(msg);
+    }
+    executor.run();
+
+    /// Messages added through the C interface reach waiters on dispatch
+    snprintf(msg , sizeof(msg) , "added");
+    MailboxAddMail(msg);
+    box.dispatch();
+    executor.run();
+
+    printf("still waiting %d\n" , box.waiting());
+
+    return 0;
+}
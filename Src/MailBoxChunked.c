@@ -0,0 +1,417 @@
+/**
+ * @file MailBoxChunked.c
+ * @author vishal k
+ * @brief Mailbox implementation using an unrolled list of message chunks
+ * @date 2021-03-06
+ * 
+ * Variant of the dynamic mailbox for deep mailboxes. Each list node holds up to @ref MAIL_CHUNK_MSGS
+ * messages behind a two byte occupancy header, so the link and header cost is shared by the chunk and
+ * walking to a message follows one pointer per chunk instead of one per message.
+ * 
+ * Chunks are allocated when the tail chunk is full and released when they run empty. A delete that leaves
+ * a chunk small enough to take its successor merges the two, so chunks stay at least half full apart
+ * from the head and tail. Only the core operations are provided, it is not selectable in @ref UsrConfig.h.
+ * Its capacity is @ref MAILBOX_CHUNKED_MAX_MAILS rather than @ref MAX_MAILS so it can grow deep.
+ * 
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MailBoxChunked.h"
+#include "UsrConfig.h"
+
+/**
+ * @brief Helper function to get an empty chunk, the spare chunk is used before allocating
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return sMailChunk_t* empty chunk
+ */
+static sMailChunk_t* MailboxChunkedNewChunk(sMailBoxChunked_t* const Me)
+{
+    sMailChunk_t* pChunk = Me->Spare ;
+
+    if(NULL != pChunk)
+    {
+        Me->Spare = NULL ;
+    }
+    else
+    {
+        pChunk = (sMailChunk_t*)malloc(sizeof(sMailChunk_t));
+        assert(NULL != pChunk);
+    }
+
+    pChunk->next = NULL ;
+    pChunk->first = 0 ;
+    pChunk->count = 0 ;
+    Me->ChunkNum++ ;
+
+    return pChunk;
+}
+
+/**
+ * @brief Helper function to release a chunk that is no longer linked, one chunk is kept as spare
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pChunk chunk to release
+ */
+static void MailboxChunkedFreeChunk(sMailBoxChunked_t* const Me , sMailChunk_t* const pChunk)
+{
+    #ifdef MAILBOX_SECURE_WIPE
+    memset(pChunk->Msgs , 0 , sizeof(pChunk->Msgs));
+    #endif
+
+    Me->ChunkNum-- ;
+
+    if(NULL == Me->Spare)
+    {
+        Me->Spare = pChunk ;
+    }
+    else
+    {
+        free(pChunk);
+    }
+}
+
+/**
+ * @brief Helper function that unlinks and releases a chunk
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pPrev chunk before @ref pChunk , NULL for the head
+ * @param pChunk chunk to remove
+ */
+static void MailboxChunkedUnlink(sMailBoxChunked_t* const Me , sMailChunk_t* const pPrev , sMailChunk_t* const pChunk)
+{
+    if(NULL == pPrev)
+    {
+        Me->head = pChunk->next ;
+    }
+    else
+    {
+        pPrev->next = pChunk->next ;
+    }
+
+    if(Me->tail == pChunk)
+    {
+        Me->tail = pPrev ;
+    }
+    MailboxChunkedFreeChunk(Me,pChunk);
+}
+
+/**
+ * @brief Helper function that moves the messages of a chunk to the start of the chunk
+ * 
+ * @param pChunk chunk
+ */
+static void MailboxChunkedCompact(sMailChunk_t* const pChunk)
+{
+    if(0 != pChunk->first)
+    {
+        memmove(pChunk->Msgs[0] , pChunk->Msgs[pChunk->first] , pChunk->count * MAX_MSG_SIZE);
+        pChunk->first = 0 ;
+    }
+}
+
+/**
+ * @brief Helper function that finds the chunk holding a logical index, walks one chunk at a time
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param index logical index, less than @ref sMailBoxChunked_t::ActiveMsgNum
+ * @param ppPrev will be updated with the chunk before the returned one, may be NULL
+ * @param pPos will be updated with the position of the message among the live messages of the chunk
+ * @return sMailChunk_t* chunk holding the message
+ */
+static sMailChunk_t* MailboxChunkedLocate(sMailBoxChunked_t const* const Me , size_t index , sMailChunk_t** ppPrev , size_t* pPos)
+{
+    sMailChunk_t* pPrev = NULL ;
+    sMailChunk_t* pChunk = Me->head ;
+
+    while(index >= pChunk->count)
+    {
+        index -= pChunk->count ;
+        pPrev = pChunk ;
+        pChunk = pChunk->next ;
+    }
+
+    if(NULL != ppPrev)
+    {
+        *ppPrev = pPrev ;
+    }
+    *pPos = index ;
+
+    return pChunk;
+}
+
+/**
+ * @brief Helper function that removes the message at a logical index
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param index logical index, less than @ref sMailBoxChunked_t::ActiveMsgNum
+ */
+static void MailboxChunkedRemoveAt(sMailBoxChunked_t* const Me , size_t index)
+{
+    sMailChunk_t* pPrev = NULL ;
+    size_t pos = 0 ;
+    sMailChunk_t* pChunk = MailboxChunkedLocate(Me , index , &pPrev , &pos) ;
+
+    /// Removing the oldest message of a chunk only moves its start
+    if(0 == pos)
+    {
+        #ifdef MAILBOX_SECURE_WIPE
+        memset(pChunk->Msgs[pChunk->first] , 0 , MAX_MSG_SIZE);
+        #endif
+        pChunk->first++ ;
+    }
+    else
+    {
+        size_t slot = pChunk->first + pos ;
+
+        memmove(pChunk->Msgs[slot] , pChunk->Msgs[slot + 1] , (pChunk->count - pos - 1) * MAX_MSG_SIZE);
+        #ifdef MAILBOX_SECURE_WIPE
+        memset(pChunk->Msgs[pChunk->first + pChunk->count - 1] , 0 , MAX_MSG_SIZE);
+        #endif
+    }
+    pChunk->count-- ;
+
+    if(0 == pChunk->count)
+    {
+        MailboxChunkedUnlink(Me,pPrev,pChunk);
+    }
+    /// Take over the next chunk if both fit in one
+    else if( (NULL != pChunk->next) && ((size_t)(pChunk->count + pChunk->next->count) <= MAIL_CHUNK_MSGS) )
+    {
+        sMailChunk_t* pNext = pChunk->next ;
+
+        MailboxChunkedCompact(pChunk);
+        memcpy(pChunk->Msgs[pChunk->count] , pNext->Msgs[pNext->first] , pNext->count * MAX_MSG_SIZE);
+        pChunk->count += pNext->count ;
+        MailboxChunkedUnlink(Me,pChunk,pNext);
+    }
+
+    /// Keep the current message on screen the same
+    if(Me->CurMsgIndex > index)
+    {
+        Me->CurMsgIndex-- ;
+    }
+    Me->ActiveMsgNum-- ;
+
+    if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+    }
+}
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxChunkedInit(sMailBoxChunked_t* const Me)
+{
+    assert(NULL != Me);
+
+    Me->head = NULL ;
+    Me->tail = NULL ;
+    Me->Spare = NULL ;
+    Me->ChunkNum = 0 ;
+    Me->CurMsgIndex = 0 ;
+    Me->ActiveMsgNum = 0 ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Remove all messages and hand every chunk back to the heap
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxChunkedDeinit(sMailBoxChunked_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxChunkedClear(Me);
+    free(Me->Spare);
+    Me->Spare = NULL ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Remove all messages, linear in the number of chunks
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxChunkedClear(sMailBoxChunked_t* const Me)
+{
+    assert(NULL != Me);
+
+    while(NULL != Me->head)
+    {
+        MailboxChunkedUnlink(Me , NULL , Me->head);
+    }
+
+    Me->CurMsgIndex = 0 ;
+    Me->ActiveMsgNum = 0 ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Add new message to mailbox, the oldest message is dropped if the mailbox is full
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg message
+ * @return eMailStatus_t @ref E_MAILBOXOVERWRITTEN if the oldest message was dropped
+ */
+eMailStatus_t MailboxChunkedAddMail(sMailBoxChunked_t* const Me , const char* const msg)
+{
+    assert(NULL != Me);
+    assert(NULL != msg);
+
+    eMailStatus_t status = E_NOERROR ;
+
+    if(Me->ActiveMsgNum >= MAILBOX_CHUNKED_MAX_MAILS)
+    {
+        MailboxChunkedRemoveAt(Me,0);
+        status = E_MAILBOXOVERWRITTEN ;
+    }
+
+    /// Tail chunk has no free slot at its end, reuse the slots freed at its start or link a new chunk
+    if( (NULL != Me->tail) && ((size_t)(Me->tail->first + Me->tail->count) == MAIL_CHUNK_MSGS) && (0 != Me->tail->first) )
+    {
+        MailboxChunkedCompact(Me->tail);
+    }
+
+    if( (NULL == Me->tail) || ((size_t)(Me->tail->first + Me->tail->count) == MAIL_CHUNK_MSGS) )
+    {
+        sMailChunk_t* pChunk = MailboxChunkedNewChunk(Me) ;
+
+        if(NULL == Me->tail)
+        {
+            Me->head = pChunk ;
+        }
+        else
+        {
+            Me->tail->next = pChunk ;
+        }
+        Me->tail = pChunk ;
+    }
+
+    memcpy(Me->tail->Msgs[Me->tail->first + Me->tail->count] , msg , MAX_MSG_SIZE);
+    Me->tail->count++ ;
+    Me->ActiveMsgNum++ ;
+
+    return status;
+}
+
+/**
+ * @brief Put the current message into @ref msg
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the current message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxChunkedview(sMailBoxChunked_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    return MailboxChunkedViewAt(Me , Me->CurMsgIndex , msg);
+}
+
+/**
+ * @brief scroll to the next message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no other message to scroll to
+ */
+eMailStatus_t MailboxChunkedScrollNext(sMailBoxChunked_t* const Me)
+{
+    assert(NULL != Me);
+
+    if(1 >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+        return E_MAILBOXEMPTY;
+    }
+
+    Me->CurMsgIndex++ ;
+
+    ///If end of the mailbox is reached go back to the oldest message
+    if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+    }
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Delete the currently viewing message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxChunkedDeleteMail(sMailBoxChunked_t* const Me)
+{
+    assert(NULL != Me);
+
+    if(0 == Me->ActiveMsgNum)
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    MailboxChunkedRemoveAt(Me , Me->CurMsgIndex);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Take the oldest message out of the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxChunkedReceive(sMailBoxChunked_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    if(0 == Me->ActiveMsgNum)
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    memcpy(msg , Me->head->Msgs[Me->head->first] , MAX_MSG_SIZE);
+    MailboxChunkedRemoveAt(Me,0);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Copy the message at a logical index
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param index logical index, 0 is the oldest message
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no message at @ref index
+ */
+eMailStatus_t MailboxChunkedViewAt(sMailBoxChunked_t* const Me , size_t index , char* const msg)
+{
+    assert(NULL != Me);
+
+    size_t pos = 0 ;
+
+    if(index >= Me->ActiveMsgNum)
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    sMailChunk_t const* pChunk = MailboxChunkedLocate(Me , index , NULL , &pos) ;
+
+    memcpy(msg , pChunk->Msgs[pChunk->first + pos] , MAX_MSG_SIZE);
+
+    return E_NOERROR;
+}
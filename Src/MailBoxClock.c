@@ -0,0 +1,26 @@
+/**
+ * @file MailBoxClock.c
+ * @author vishal k
+ * @brief Monotonic clock used to timestamp messages on add
+ * @date 2021-03-06
+ * @note Uses CLOCK_MONOTONIC which is served from the vDSO without a system call.
+ *       Replace with a free running hardware timer read when porting to a target without POSIX clocks
+ * 
+ */
+
+#include <time.h>
+#include "MailBoxClock.h"
+
+/**
+ * @brief Current time
+ * 
+ * @return uint64_t nanoseconds since an arbitrary fixed point, never goes backwards
+ */
+uint64_t MailboxClockNow()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC , &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec ;
+}
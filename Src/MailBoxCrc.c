@@ -0,0 +1,124 @@
+/**
+ * @file MailBoxCrc.c
+ * @author vishal k
+ * @brief CRC32C of message payloads
+ * @date 2021-03-06
+ * 
+ * Uses the SSE4.2 crc32 instruction when the cpu has it, eight bytes per instruction, and a byte wise
+ * table otherwise. The choice is made, and the table built, once on the first call.
+ * 
+ */
+#include <string.h>
+#include <pthread.h>
+#ifdef __x86_64__
+#include <nmmintrin.h>
+#endif
+
+#include "MailBoxCrc.h"
+
+static const uint32_t MAIL_CRC32C_POLY = 0x82F63B78 ;     //> Castagnoli polynomial, bit reversed
+
+typedef uint32_t (*MailboxCrcFn_t)(const uint8_t* p , size_t len);
+
+static uint32_t MailboxCrcTable[256];                     /**< Remainder of every byte value, built on first use*/
+static MailboxCrcFn_t MailboxCrcFn = NULL ;               /**< Implementation chosen on the first call*/
+static pthread_once_t MailboxCrcOnce = PTHREAD_ONCE_INIT ; /**< Runs @ref MailboxCrcSelect exactly once*/
+
+/**
+ * @brief Helper function, table driven CRC32C for cpus without SSE4.2
+ * 
+ * @param p data
+ * @param len bytes
+ * @return uint32_t checksum
+ */
+static uint32_t MailboxCrcSoft(const uint8_t* p , size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF ;
+
+    for(size_t i = 0 ; i < len ; i++)
+    {
+        crc = MailboxCrcTable[(crc ^ p[i]) & 0xFF] ^ (crc >> 8) ;
+    }
+
+    return ~crc;
+}
+
+#ifdef __x86_64__
+/**
+ * @brief Helper function, CRC32C with the SSE4.2 crc32 instruction
+ * 
+ * @param p data
+ * @param len bytes
+ * @return uint32_t checksum
+ */
+__attribute__((target("sse4.2"))) static uint32_t MailboxCrcHw(const uint8_t* p , size_t len)
+{
+    uint64_t crc = 0xFFFFFFFF ;
+
+    for( ; len >= sizeof(uint64_t) ; len -= sizeof(uint64_t) , p += sizeof(uint64_t))
+    {
+        uint64_t word = 0 ;
+
+        memcpy(&word , p , sizeof(word));
+        crc = _mm_crc32_u64(crc , word) ;
+    }
+
+    uint32_t crc32 = (uint32_t)crc ;
+
+    for( ; 0 != len ; len-- , p++)
+    {
+        crc32 = _mm_crc32_u8(crc32 , *p) ;
+    }
+
+    return ~crc32;
+}
+#endif
+
+/**
+ * @brief Helper function that picks the implementation for this cpu and builds the table if it needs it,
+ * run once through @ref MailboxCrcOnce
+ */
+static void MailboxCrcSelect(void)
+{
+    #ifdef __x86_64__
+    if(0 != __builtin_cpu_supports("sse4.2"))
+    {
+        __atomic_store_n(&MailboxCrcFn , &MailboxCrcHw , __ATOMIC_RELEASE);
+        return ;
+    }
+    #endif
+
+    for(uint32_t i = 0 ; i < 256 ; i++)
+    {
+        uint32_t crc = i ;
+
+        for(size_t bit = 0 ; bit < 8 ; bit++)
+        {
+            crc = (crc >> 1) ^ ( (0 != (crc & 1)) ? MAIL_CRC32C_POLY : 0 ) ;
+        }
+        MailboxCrcTable[i] = crc ;
+    }
+
+    __atomic_store_n(&MailboxCrcFn , &MailboxCrcSoft , __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief CRC32C (Castagnoli) of a buffer
+ * 
+ * @param data buffer
+ * @param len bytes
+ * @return uint32_t checksum
+ */
+uint32_t MailboxCrc32c(const void* const data , size_t len)
+{
+    MailboxCrcFn_t fn = __atomic_load_n(&MailboxCrcFn , __ATOMIC_ACQUIRE) ;
+
+    /// Threads racing on the first call wait until the table is complete
+    if(NULL == fn)
+    {
+        pthread_once(&MailboxCrcOnce , MailboxCrcSelect);
+        fn = __atomic_load_n(&MailboxCrcFn , __ATOMIC_ACQUIRE) ;
+    }
+
+    return fn((const uint8_t*)data , len);
+}
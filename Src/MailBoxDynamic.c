@@ -12,238 +12,1640 @@
 #include <string.h>
 #include "UsrConfig.h"
 #include "MailBoxDynamic.h"
+#include "MailBoxClock.h"
+#include "MailBoxCrc.h"
 
 #ifdef USE_DYNAMIC_MAILBOX
 
 /**
- * @brief Helper function to create new node
+ * @brief Timer callback, marks the node as expired and queues it. It is removed on the next call into the mailbox
+ *        or by an add blocked on the full mailbox, which is woken
  * 
- * @param newMsg data for the new created node
+ * @param pTimer timer embedded in @ref sMailNode_t
+ */
+static void MailboxDynamicTimerExpired(sMailTimer_t* const pTimer)
+{
+    sMailBoxDynamic_t* Me = (sMailBoxDynamic_t*)pTimer->owner ;
+    sMailNode_t* pMail = (sMailNode_t*)((char*)pTimer - offsetof(sMailNode_t , Timer)) ;
+
+    /// Nodes moved to the free list by @ref MailboxDynamicClear keep their timer running, ignore them
+    if(Me->Gen == pMail->gen)
+    {
+        MailboxSeqLockWriteBegin(&Me->Lock);
+        pMail->expired = true ;
+        MailboxSeqLockWriteEnd(&Me->Lock);
+        pMail->ExpiredNext = Me->Expired ;
+        Me->Expired = pMail ;
+        Me->ExpiredNum++ ;
+        MailboxOverflowWake(&Me->Overflow);
+    }
+}
+
+/**
+ * @brief Helper function to call after every change of the message count, updates readiness and wakes blocked adds
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxDynamicCountChanged(sMailBoxDynamic_t* const Me)
+{
+    MailboxEventFdUpdate(&Me->Notify , 0 != Me->ActiveMsgNum);
+    MailboxOverflowUpdate(&Me->Overflow , Me->ActiveMsgNum);
+}
+
+/**
+ * @brief Helper function that stores the checksum of a node, call after every change of its payload
+ * 
+ * @param pMail node
+ */
+static void MailboxDynamicSeal(sMailNode_t* const pMail)
+{
+    #ifdef MAILBOX_CHECKSUM
+    pMail->crc = MailboxCrc32c(pMail->msg , MAX_MSG_SIZE) ;
+    #else
+    (void)pMail;
+    #endif
+}
+
+/**
+ * @brief Helper function that checks the payload of a node against its checksum
+ * 
+ * @param pMail node
+ * @return eMailStatus_t @ref E_MAILBOXCORRUPT if the payload changed since it was added
+ */
+static eMailStatus_t MailboxDynamicVerify(sMailNode_t const* const pMail)
+{
+    #ifdef MAILBOX_CHECKSUM
+    if(pMail->crc != MailboxCrc32c(pMail->msg , MAX_MSG_SIZE))
+    {
+        return E_MAILBOXCORRUPT;
+    }
+    #else
+    (void)pMail;
+    #endif
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Helper function to create new node, reuses released nodes before allocating
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newMsg data for the new created node , NULL leaves filling the payload to the caller
  * @return sMailNode_t* pointer to the new node created
  */
-static sMailNode_t* MailboxDynamicNewMail(const char* const newMsg)
+static sMailNode_t* MailboxDynamicNewMail(sMailBoxDynamic_t* const Me , const char* const newMsg)
+{
+    sMailNode_t* pNewsMailNode = Me->FreeList ;
+
+    if(NULL != pNewsMailNode)
+    {
+        Me->FreeList = pNewsMailNode->next ;
+
+        /// Timer may still be running from before the clear
+        if(NULL != Me->Wheel)
+        {
+            MailboxTimerStop(Me->Wheel , &pNewsMailNode->Timer);
+        }
+    }
+    else
+    {
+        pNewsMailNode = (NULL != Me->Memory) ? (sMailNode_t*)MailboxMemoryAlloc(Me->Memory , sizeof(sMailNode_t))
+                                             : (sMailNode_t*)malloc(sizeof(sMailNode_t));
+        assert(NULL != pNewsMailNode);
+        MailboxTimerInit(&pNewsMailNode->Timer , Me , MailboxDynamicTimerExpired);
+    }
+
+    if(NULL != newMsg)
+    {
+        memcpy(pNewsMailNode->msg , newMsg , MAX_MSG_SIZE);
+        MailboxDynamicSeal(pNewsMailNode);
+    }
+    pNewsMailNode->keyed = false ;
+    pNewsMailNode->expired = false ;
+    pNewsMailNode->gen = Me->Gen ;
+    pNewsMailNode->timestamp = MailboxClockNow() ;
+    pNewsMailNode->next = NULL ;
+    pNewsMailNode->prev = NULL ;
+
+    return pNewsMailNode ;
+}
+
+/**
+ * @brief Helper function that appends a node to the list of its tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMail node
+ * @param tag message tag
+ */
+static void MailboxDynamicTagLink(sMailBoxDynamic_t* const Me , sMailNode_t* const pMail , uint8_t tag)
+{
+    pMail->tag = tag ;
+    pMail->TagNext = NULL ;
+    pMail->TagPrev = Me->TagTail[tag] ;
+
+    if(NULL == Me->TagTail[tag])
+    {
+        Me->TagHead[tag] = pMail ;
+    }
+    else
+    {
+        Me->TagTail[tag]->TagNext = pMail ;
+    }
+    Me->TagTail[tag] = pMail ;
+}
+
+/**
+ * @brief Helper function that takes a node out of the list of its tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMail node in the mailbox
+ */
+static void MailboxDynamicTagUnlink(sMailBoxDynamic_t* const Me , sMailNode_t* const pMail)
+{
+    if(NULL == pMail->TagPrev)
+    {
+        Me->TagHead[pMail->tag] = pMail->TagNext ;
+    }
+    else
+    {
+        pMail->TagPrev->TagNext = pMail->TagNext ;
+    }
+
+    if(NULL == pMail->TagNext)
+    {
+        Me->TagTail[pMail->tag] = pMail->TagPrev ;
+    }
+    else
+    {
+        pMail->TagNext->TagPrev = pMail->TagPrev ;
+    }
+}
+
+/**
+ * @brief Helper function to release a node to the free list, drops its key table entry if it has one
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMail node to release, may be NULL
+ * @note Nodes are never handed back to the heap, a snapshot reader that still follows a released node reads
+ * valid memory and retries
+ */
+static void MailboxDynamicFreeMail(sMailBoxDynamic_t* const Me , sMailNode_t* const pMail)
+{
+    if( (NULL != pMail) && (true == pMail->keyed) )
+    {
+        MailboxKeyTableRemove(&Me->Keys , pMail->key);
+    }
+
+    if( (NULL != pMail) && (NULL != Me->Wheel) )
+    {
+        MailboxTimerStop(Me->Wheel , &pMail->Timer);
+    }
+
+    if(NULL != pMail)
+    {
+        MailboxDynamicTagUnlink(Me,pMail);
+    }
+
+    #ifdef MAILBOX_SECURE_WIPE
+    if(NULL != pMail)
+    {
+        memset(pMail->msg , 0 , MAX_MSG_SIZE);
+    }
+    #endif
+
+    if(NULL != pMail)
+    {
+        /// Still queued for the purge if its timer fired, the purge skips it
+        pMail->expired = false ;
+        pMail->next = Me->FreeList ;
+        Me->FreeList = pMail ;
+    }
+}
+
+/**
+ * @brief Helper function that unlinks and frees any node of the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMail node in the mailbox
+ * @note Unlinking is constant time, only a scrolled mailbox walks up to the current message to keep it on screen
+ */
+static void MailboxDynamicRemoveNode(sMailBoxDynamic_t* const Me , sMailNode_t* const pMail)
+{
+    bool beforeCur = false ;
+    sMailNode_t* iter = Me->head ;
+
+    /// The current message moves down only if the removed node is older than it
+    for(size_t i = 0 ; (i < Me->CurMsgIndex) && (NULL != iter) ; i++)
+    {
+        if(iter == pMail)
+        {
+            beforeCur = true ;
+            break;
+        }
+        iter = iter->next ;
+    }
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    if(NULL == pMail->prev)
+    {
+        Me->head = pMail->next ;
+    }
+    else
+    {
+        pMail->prev->next = pMail->next ;
+    }
+
+    if(NULL == pMail->next)
+    {
+        Me->tail = pMail->prev ;
+    }
+    else
+    {
+        pMail->next->prev = pMail->prev ;
+    }
+    MailboxDynamicFreeMail(Me,pMail);
+
+    /// Keep the current message on screen the same
+    if(true == beforeCur)
+    {
+        Me->CurMsgIndex-- ;
+    }
+    Me->ActiveMsgNum-- ;
+
+    if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxDynamicCountChanged(Me);
+}
+
+/**
+ * @brief Helper function that removes the nodes whose timer fired since the last call
+ * 
+ * Only the nodes queued by @ref MailboxDynamicTimerExpired are visited. A queued node that was released
+ * meanwhile has its expired flag cleared and is skipped.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxDynamicPurgeExpired(sMailBoxDynamic_t* const Me)
+{
+    while(NULL != Me->Expired)
+    {
+        sMailNode_t* pMail = Me->Expired ;
+
+        Me->Expired = pMail->ExpiredNext ;
+
+        if( (Me->Gen == pMail->gen) && (true == pMail->expired) )
+        {
+            MailboxDynamicRemoveNode(Me,pMail);
+        }
+    }
+}
+
+/**
+ * @brief Helper function for @ref MailboxOverflowAdmit , removes the nodes expired while an add waits
+ * 
+ * @param pOwner mailbox , @ref sMailBoxDynamic_t
+ */
+static void MailboxDynamicReclaimExpired(void* pOwner)
+{
+    MailboxDynamicPurgeExpired((sMailBoxDynamic_t*)pOwner);
+}
+
+/**
+ * @brief Helper function that tells if any open reader has already passed a message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param seq sequence number of the message
+ * @return true if at least one open reader is past the message
+ */
+static bool MailboxDynamicReaderPassed(sMailBoxDynamic_t const* const Me , uint32_t seq)
+{
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && (Me->Readers[i].NextSeq > seq) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Helper function that gives the lowest position among the open readers
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMinSeq will be updated with the smallest @ref sMailReader_t::NextSeq of the open readers
+ * @return true if at least one reader is open
+ */
+static bool MailboxDynamicReaderMinSeq(sMailBoxDynamic_t const* const Me , uint32_t* pMinSeq)
+{
+    bool found = false ;
+
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && ( (false == found) || (Me->Readers[i].NextSeq < *pMinSeq) ) )
+        {
+            *pMinSeq = Me->Readers[i].NextSeq ;
+            found = true ;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Helper function that returns the oldest node with sequence number at or after @ref seq
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param seq Reader position to search from
+ * @return sMailNode_t* matching node, NULL if the reader has passed all messages
+ */
+static sMailNode_t* MailboxDynamicFindSeq(sMailBoxDynamic_t const* const Me , uint32_t seq)
+{
+    sMailNode_t* iter = Me->head ;
+
+    /// Nodes are appended in sequence order, the first match is the next message for the reader
+    while( (NULL != iter) && (iter->seq < seq) )
+    {
+        iter = iter->next ;
+    }
+
+    return iter;
+}
+
+/**
+ * @brief Helper function that frees the oldest nodes once every open reader has passed them
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxDynamicReclaim(sMailBoxDynamic_t* const Me)
+{
+    uint32_t minSeq = 0 ;
+    sMailNode_t* iter = NULL ;
+
+    if(false == MailboxDynamicReaderMinSeq(Me,&minSeq))
+    {
+        return ;
+    }
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    while( (NULL != Me->head) && (Me->head->seq < minSeq) )
+    {
+        iter = Me->head ;
+        Me->head = Me->head->next ;
+        MailboxDynamicFreeMail(Me,iter);
+
+        if(NULL == Me->head)
+        {
+            Me->tail = NULL ;
+        }
+        else
+        {
+            Me->head->prev = NULL ;
+        }
+
+        /// Keep the current message on screen the same
+        if(Me->CurMsgIndex > 0)
+        {
+            Me->CurMsgIndex-- ;
+        }
+        Me->ActiveMsgNum-- ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxDynamicCountChanged(Me);
+}
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicInit(sMailBoxDynamic_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxSeqLockInit(&Me->Lock);
+    MailboxEventFdInit(&Me->Notify);
+    MailboxOverflowInit(&Me->Overflow);
+    Me->head = NULL;
+    Me->tail = NULL;
+    Me->FreeList = NULL;
+    Me->CurMsgIndex  = 0;
+    Me->ActiveMsgNum = 0;
+    Me->NextSeq = 0;
+    Me->Gen = 0;
+    Me->Wheel = NULL;
+    Me->Expired = NULL;
+    Me->ExpiredNum = 0;
+    Me->Memory = NULL;
+
+    for(size_t i = 0 ; i < MAX_TAGS ; i++)
+    {
+        Me->TagHead[i] = NULL ;
+        Me->TagTail[i] = NULL ;
+    }
+    Me->LapPolicy = E_LAP_OVERWRITE;
+    MailboxKeyTableInit(&Me->Keys);
+
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        Me->Readers[i].active = false ;
+        Me->Readers[i].NextSeq = 0 ;
+    }
+
+    return E_NOERROR;
+
+}
+
+/**
+ * @brief Remove all messages in constant time
+ * 
+ * The whole list is moved to the free list of the mailbox, later adds take their nodes from there
+ * instead of allocating. Readers stay open and continue with the messages added after the clear.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ * @note With @ref MAILBOX_SECURE_WIPE the payloads are zeroed as well, which makes the clear linear
+ */
+eMailStatus_t MailboxDynamicClear(sMailBoxDynamic_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
+    if(NULL != Me->head)
+    {
+        #ifdef MAILBOX_SECURE_WIPE
+        for(sMailNode_t* iter = Me->head ; NULL != iter ; iter = iter->next)
+        {
+            memset(iter->msg , 0 , MAX_MSG_SIZE);
+        }
+        #endif
+
+        Me->tail->next = Me->FreeList ;
+        Me->FreeList = Me->head ;
+    }
+
+    Me->head = NULL ;
+    Me->tail = NULL ;
+    Me->ActiveMsgNum = 0 ;
+    Me->CurMsgIndex = 0 ;
+    Me->Gen++ ;
+    Me->Expired = NULL ;
+    MailboxKeyTableClear(&Me->Keys);
+
+    for(size_t i = 0 ; i < MAX_TAGS ; i++)
+    {
+        Me->TagHead[i] = NULL ;
+        Me->TagTail[i] = NULL ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxDynamicCountChanged(Me);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Release what @ref MailboxDynamicInit and the adds set up
+ * 
+ * Stops the expiry timers, hands the nodes back to the heap unless they came from a memory provider, closes
+ * the readiness descriptor and destroys the overflow condition variable. Call it before the mailbox is
+ * initialized again or goes away, no add may be blocked in it.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicDeinit(sMailBoxDynamic_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxDynamicClear(Me);
+
+    /// Nodes moved to the free list by a clear may still have a timer running
+    while(NULL != Me->FreeList)
+    {
+        sMailNode_t* pMail = Me->FreeList ;
+
+        Me->FreeList = pMail->next ;
+
+        if(NULL != Me->Wheel)
+        {
+            MailboxTimerStop(Me->Wheel , &pMail->Timer);
+        }
+
+        if(NULL == Me->Memory)
+        {
+            free(pMail);
+        }
+    }
+    MailboxEventFdClose(&Me->Notify);
+    MailboxOverflowDeinit(&Me->Overflow);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Helper function that decides whether a new node may be added
+ * 
+ * Runs before any write section is opened since a blocking overflow policy releases the caller's lock
+ * while it waits.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_NOERROR if the node may be added
+ */
+static eMailStatus_t MailboxDynamicAdmit(sMailBoxDynamic_t* const Me)
+{
+    uint32_t minSeq = 0 ;
+
+    /// Expired messages make room before anything gets overwritten
+    MailboxDynamicPurgeExpired(Me);
+
+    /// Oldest message is still unread by a reader, reject the new message if lapping is not allowed
+    if( (Me->ActiveMsgNum >= MAX_MAILS) && (E_LAP_REJECT == Me->LapPolicy) && (true == MailboxDynamicReaderMinSeq(Me,&minSeq)) )
+    {
+        if(Me->head->seq >= minSeq)
+        {
+            return E_MAILBOXFULL;
+        }
+    }
+
+    /// Full mailbox, the overflow policy decides between dropping the oldest, rejecting and waiting
+    return MailboxOverflowAdmit(&Me->Overflow , &Me->ActiveMsgNum , MailboxDynamicReclaimExpired , Me);
+}
+
+/**
+ * @brief Helper function that inserts an admitted node at the end , utilizes @ref MailboxDynamicNewMail
+ * 
+ * The caller reports the count change once the payload is in place.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newmsg data for the new node , NULL leaves filling the payload to the caller
+ * @param tag message tag
+ * @param ppMail will be updated with the appended node
+ * @return eMailStatus_t @ref E_MAILBOXOVERWRITTEN if the oldest node was dropped for it
+ */
+static eMailStatus_t MailboxDynamicInsert(sMailBoxDynamic_t* const Me, const char* const newmsg, uint8_t tag, sMailNode_t** ppMail)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    sMailNode_t* pNewsMailNode = MailboxDynamicNewMail(Me,newmsg);
+    pNewsMailNode->seq = Me->NextSeq++ ;
+
+    sMailNode_t* iter = Me->head ;
+
+    /// If no nodes are present make the new node head 
+    if(NULL == iter)
+    {
+        Me->head = pNewsMailNode ;
+    }
+    else
+    {
+        /// Append node to the end of the list
+        Me->tail->next = pNewsMailNode ;
+        pNewsMailNode->prev = Me->tail ;
+    }
+    Me->tail = pNewsMailNode ;
+    MailboxDynamicTagLink(Me,pNewsMailNode,tag);
+
+    /// If number of nodes exceed predefined max nodes, then free oldest node 
+    if(Me->ActiveMsgNum >= MAX_MAILS)
+    {
+        iter = Me->head;
+        Me->head = Me->head->next;
+        Me->head->prev = NULL ;
+        MailboxDynamicFreeMail(Me,iter);
+        status = E_MAILBOXOVERWRITTEN ;
+    }
+    /// Update active message count 
+    else
+    {
+        Me->ActiveMsgNum++;
+    }
+
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    *ppMail = pNewsMailNode ;
+    
+    return status;
+
+}
+
+/**
+ * @brief Helper function that appends a new node , utilizes @ref MailboxDynamicNewMail
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newmsg data for the new node
+ * @param tag message tag
+ * @param ppMail will be updated with the appended node , NULL if nothing was added
+ * @return eMailStatus_t @ref E_MAILBOXOVERWRITTEN if the oldest node was dropped for it
+ */
+static eMailStatus_t MailboxDynamicAppend(sMailBoxDynamic_t* const Me, const char* const newmsg, uint8_t tag, sMailNode_t** ppMail)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    *ppMail = NULL ;
+
+    status = MailboxDynamicAdmit(Me) ;
+
+    if(E_NOERROR != status)
+    {
+        return status;
+    }
+
+    status = MailboxDynamicInsert(Me,newmsg,tag,ppMail) ;
+    MailboxDynamicCountChanged(Me);
+
+    return status;
+}
+
+/**
+ * @brief Add new node , utilizes @ref MailboxDynamicNewMail
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newmsg data for the new node
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicAddMail(sMailBoxDynamic_t* const Me, const char* const newmsg)
+{
+    assert(NULL != Me);
+    assert(NULL != newmsg);
+
+    sMailNode_t* pMail = NULL ;
+
+    return MailboxDynamicAppend(Me,newmsg,0,&pMail);
+}
+
+/**
+ * @brief Add a message that only matters as the latest value for its key
+ * 
+ * If a node with the same key is still pending its payload is replaced in place and it keeps its position,
+ * otherwise a new node is appended. A node that an open reader has already passed is left alone and the
+ * new value is appended so that reader still gets it.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param key message key
+ * @param newmsg data for the node
+ * @return eMailStatus_t @ref E_MAILBOXCOALESCED if a pending node was replaced
+ */
+eMailStatus_t MailboxDynamicAddMailKeyed(sMailBoxDynamic_t* const Me, uint32_t key, const char* const newmsg)
+{
+    assert(NULL != Me);
+    assert(NULL != newmsg);
+
+    eMailStatus_t status = E_NOERROR ;
+
+    /// An expired node must not absorb the new value , it would be purged with it
+    MailboxDynamicPurgeExpired(Me);
+
+    sMailNode_t* pMail = (sMailNode_t*)MailboxKeyTableFind(&Me->Keys , key);
+
+    if(NULL != pMail)
+    {
+        if(false == MailboxDynamicReaderPassed(Me , pMail->seq))
+        {
+            MailboxSeqLockWriteBegin(&Me->Lock);
+            memcpy(pMail->msg , newmsg , MAX_MSG_SIZE);
+            MailboxDynamicSeal(pMail);
+            MailboxSeqLockWriteEnd(&Me->Lock);
+            return E_MAILBOXCOALESCED;
+        }
+
+        /// Old value already delivered to a reader, it stays as a plain message
+        MailboxKeyTableRemove(&Me->Keys , key);
+        pMail->keyed = false ;
+    }
+
+    status = MailboxDynamicAppend(Me,newmsg,0,&pMail);
+
+    if(NULL != pMail)
+    {
+        pMail->keyed = true ;
+        pMail->key = key ;
+        MailboxKeyTableInsert(&Me->Keys , key , pMail);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Add a node that is dropped if it is still in the mailbox after @ref ttl ticks
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newmsg data for the new node
+ * @param ttl time to live in ticks of the wheel set with @ref MailboxDynamicSetTimerWheel
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicAddMailTtl(sMailBoxDynamic_t* const Me, const char* const newmsg, uint32_t ttl)
+{
+    assert(NULL != Me);
+    assert(NULL != Me->Wheel);
+
+    eMailStatus_t status = E_NOERROR ;
+    sMailNode_t* pMail = NULL ;
+
+    status = MailboxDynamicAppend(Me,newmsg,0,&pMail);
+
+    if(NULL != pMail)
+    {
+        MailboxTimerStart(Me->Wheel , &pMail->Timer , ttl);
+    }
+
+    return status;
+}
+
+/**
+ * @brief scroll to the next message
+ * 
+ * @param Me  Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicScrollNext(sMailBoxDynamic_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxDynamicPurgeExpired(Me);
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
+    eMailStatus_t status = E_MAILBOXEMPTY ;
+
+    if(1 >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+        status = E_MAILBOXEMPTY ;
+    }
+    else 
+    {
+        sMailNode_t* iter = Me->head ;
+
+        ///Traverse to next node
+        iter = iter->next ;
+        Me->CurMsgIndex++ ;
+        
+        ///If end node is reached reset current node iterator to head node
+        if(Me->CurMsgIndex >= MAX_MAILS)
+        {
+            Me->CurMsgIndex = 0 ;
+        }
+
+        status = E_NOERROR ;
+
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    return status;
+}
+
+/**
+ * @brief View function displays the current message in the message box
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the current message
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicview(sMailBoxDynamic_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    MailboxDynamicPurgeExpired(Me);
+
+    eMailStatus_t status = E_NOERROR ;
+    sMailNode_t* iter = Me->head ;
+
+    /// If there are no messages , set buffer to null 
+    if(0 == Me->ActiveMsgNum)
+    {
+        memset(msg,0,sizeof(msg));
+        status = E_MAILBOXEMPTY ;
+    }
+    
+    else
+    {
+        ///If the current index is pointing to the last node reset the index to head
+        if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+        {
+            MailboxSeqLockWriteBegin(&Me->Lock);
+            Me->CurMsgIndex = 0 ;
+            MailboxSeqLockWriteEnd(&Me->Lock);
+        }
+
+        /// iterate over the list until the data at the current index is obtained and copy data to @ref msg
+        for(size_t i = 0; i< Me->CurMsgIndex ; i++)
+        {
+            iter = iter->next ;
+        }
+        memcpy(msg,iter->msg,MAX_MSG_SIZE);
+        status = MailboxDynamicVerify(iter) ;
+    }
+
+    return status;
+
+}
+
+/**
+ * @brief Delete the currently viewing message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicDeleteMail(sMailBoxDynamic_t* const Me )
+{
+    assert(NULL != Me);
+
+    MailboxDynamicPurgeExpired(Me);
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
+    eMailStatus_t status = E_NOERROR ;
+
+    /// If there are no messages set status to empty 
+    if(0 == Me->ActiveMsgNum )
+    {
+        status = E_MAILBOXEMPTY;
+    }
+    else
+    {
+        sMailNode_t* iter = Me->head ;
+        sMailNode_t* prevIter = iter;
+        uint8_t lCurMsgIndex = 0 ;
+
+        /// If the present message is the head node, update head node to next node 
+        if(0 == Me->CurMsgIndex)
+        {
+            prevIter = iter ;
+            iter = iter->next ;
+            Me->head = iter ;
+            MailboxDynamicFreeMail(Me,prevIter);
+
+            if(NULL == Me->head)
+            {
+                Me->tail = NULL ;
+            }
+            else
+            {
+                Me->head->prev = NULL ;
+            }
+        }
+        else
+        {
+            /// Iterate to the node to be deleted as pointed by the current index, update links and free the deleted node
+            while( (NULL != iter) && (lCurMsgIndex != Me->CurMsgIndex) )
+            {
+                ++lCurMsgIndex ;
+                prevIter = iter ;
+                iter = iter->next ;
+            }
+            ///End of the mailbox reached delete end node
+            if(NULL == iter)
+            {
+                prevIter->next = NULL ;
+                MailboxDynamicFreeMail(Me,iter);
+            }
+            else
+            {
+                prevIter->next = iter->next ;
+
+                if(Me->tail == iter)
+                {
+                    Me->tail = prevIter ;
+                }
+                else
+                {
+                    iter->next->prev = prevIter ;
+                }
+                MailboxDynamicFreeMail(Me,iter);
+            }
+            status = E_NOERROR ;
+        }
+    }
+
+    /// Reduce the activemessage count      
+    if(Me->ActiveMsgNum > 0)
+    {
+        Me->ActiveMsgNum-- ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxDynamicCountChanged(Me);
+
+    return status;
+}
+
+/**
+ * @brief Open a named reader positioned at the oldest message in the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param name Reader name, opening an already open name returns the same reader
+ * @param pReaderId will be updated with the id to be used with the reader functions
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicReaderOpen(sMailBoxDynamic_t* const Me , const char* const name , uint8_t* const pReaderId)
+{
+    assert(NULL != Me);
+    assert(NULL != name);
+    assert(NULL != pReaderId);
+
+    eMailStatus_t status = E_READERINVALID ;
+
+    /// Reuse the reader if the name is already open
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && (0 == strncmp(Me->Readers[i].name , name , MAX_READER_NAME)) )
+        {
+            *pReaderId = i ;
+            return E_NOERROR;
+        }
+    }
+
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if(false == Me->Readers[i].active)
+        {
+            Me->Readers[i].active = true ;
+            strncpy(Me->Readers[i].name , name , MAX_READER_NAME - 1);
+            Me->Readers[i].name[MAX_READER_NAME - 1] = '\0' ;
+
+            /// Start from the oldest message present, or from the next message if empty
+            Me->Readers[i].NextSeq = (NULL != Me->head) ? Me->head->seq : Me->NextSeq ;
+
+            *pReaderId = i ;
+            status = E_NOERROR ;
+            break;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Close a reader, messages held back only by this reader are freed
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxDynamicReaderOpen
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicReaderClose(sMailBoxDynamic_t* const Me , uint8_t readerId)
+{
+    assert(NULL != Me);
+
+    if( (readerId >= MAX_READERS) || (false == Me->Readers[readerId].active) )
+    {
+        return E_READERINVALID;
+    }
+
+    Me->Readers[readerId].active = false ;
+    MailboxDynamicReclaim(Me);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Put the message at the reader position into @ref msg
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxDynamicReaderOpen
+ * @param msg pointer that will be filled up with the reader's current message
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicReaderview(sMailBoxDynamic_t* const Me , uint8_t readerId , char* const msg)
+{
+    assert(NULL != Me);
+
+    eMailStatus_t status = E_READERINVALID ;
+
+    MailboxDynamicPurgeExpired(Me);
+
+    if( (readerId < MAX_READERS) && (true == Me->Readers[readerId].active) )
+    {
+        sMailNode_t* iter = MailboxDynamicFindSeq(Me , Me->Readers[readerId].NextSeq);
+        status = E_MAILBOXEMPTY ;
+
+        if(NULL != iter)
+        {
+            memcpy(msg , iter->msg , MAX_MSG_SIZE);
+            status = MailboxDynamicVerify(iter) ;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Move the reader past its current message. Unlike @ref MailboxDynamicScrollNext the reader does not wrap around
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxDynamicReaderOpen
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicReaderScrollNext(sMailBoxDynamic_t* const Me , uint8_t readerId)
+{
+    assert(NULL != Me);
+
+    eMailStatus_t status = E_READERINVALID ;
+
+    MailboxDynamicPurgeExpired(Me);
+
+    if( (readerId < MAX_READERS) && (true == Me->Readers[readerId].active) )
+    {
+        sMailNode_t* iter = MailboxDynamicFindSeq(Me , Me->Readers[readerId].NextSeq);
+        status = E_MAILBOXEMPTY ;
+
+        /// Step past the current message and free whatever all readers have now passed
+        if(NULL != iter)
+        {
+            Me->Readers[readerId].NextSeq = iter->seq + 1 ;
+            MailboxDynamicReclaim(Me);
+            status = E_NOERROR ;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Select what add does when the oldest message is still unread by a reader
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param policy @ref eMailLapPolicy_t
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicSetLapPolicy(sMailBoxDynamic_t* const Me , eMailLapPolicy_t policy)
+{
+    assert(NULL != Me);
+
+    Me->LapPolicy = policy ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Attach the timer wheel that expires messages added with @ref MailboxDynamicAddMailTtl
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pWheel wheel shared with other mailboxes, set it while no message with a time to live is present
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicSetTimerWheel(sMailBoxDynamic_t* const Me , sMailTimerWheel_t* const pWheel)
+{
+    assert(NULL != Me);
+
+    Me->Wheel = pWheel ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Select what an add does while the mailbox is full , see @ref eMailOverflowPolicy_t
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param policy @ref eMailOverflowPolicy_t
+ * @param timeout longest wait in nanoseconds for @ref E_OVERFLOW_BLOCK , @ref MAIL_WAIT_FOREVER for no limit
+ * @param pLock for @ref E_OVERFLOW_BLOCK only , must be held around every call into the mailbox and is released while an add waits
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicSetOverflowPolicy(sMailBoxDynamic_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock)
+{
+    assert(NULL != Me);
+
+    MailboxOverflowSet(&Me->Overflow , policy , timeout , pLock);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Take new nodes from a backing memory provider instead of malloc
+ * 
+ * Nodes are never freed, they stay on the free list, so the provider must outlive the mailbox.
+ * Released nodes from before the call are still reused.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMemory provider owned by the thread using the mailbox, NULL goes back to malloc
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicSetMemory(sMailBoxDynamic_t* const Me , sMailMemory_t* const pMemory)
+{
+    assert(NULL != Me);
+
+    Me->Memory = pMemory ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Number of messages that expired since init
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pCount will be updated with the count
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDynamicGetExpired(sMailBoxDynamic_t* const Me , uint32_t* const pCount)
+{
+    assert(NULL != Me);
+    assert(NULL != pCount);
+
+    *pCount = Me->ExpiredNum ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Find the messages added in the time range [@ref from , @ref to)
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param from start of the range, @ref MailboxClockNow time base
+ * @param to end of the range, not included
+ * @param pRange will be updated with the range to walk with @ref MailboxDynamicRangeNext
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message is in the range
+ * @note The start of the range is found in O(n) by walking from the head, a list has no random access. The
+ *       requested O(log n + k) is met by @ref MailboxStaticRangeQuery only
+ */
+eMailStatus_t MailboxDynamicRangeQuery(sMailBoxDynamic_t* const Me , uint64_t from , uint64_t to , sMailRange_t* const pRange)
+{
+    assert(NULL != Me);
+    assert(NULL != pRange);
+
+    MailboxDynamicPurgeExpired(Me);
+
+    sMailNode_t* iter = Me->head ;
+
+    /// Nodes are appended in add order so their timestamps never decrease along the list
+    while( (NULL != iter) && (iter->timestamp < from) )
+    {
+        iter = iter->next ;
+    }
+
+    pRange->Next = iter ;
+    pRange->To = to ;
+
+    return ( (NULL != iter) && (iter->timestamp < to) ) ? E_NOERROR : E_MAILBOXEMPTY ;
+}
+
+/**
+ * @brief Copy the next message of a range into @ref msg
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pRange range from @ref MailboxDynamicRangeQuery
+ * @param msg pointer that will be filled up with the message
+ * @param pTimestamp will be updated with the time the message was added, may be NULL
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY once the range is done
+ */
+eMailStatus_t MailboxDynamicRangeNext(sMailBoxDynamic_t* const Me , sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp)
+{
+    assert(NULL != Me);
+    assert(NULL != pRange);
+
+    sMailNode_t* iter = (sMailNode_t*)pRange->Next ;
+
+    /// Messages that expired while the range is walked are skipped
+    while( (NULL != iter) && (iter->timestamp < pRange->To) )
+    {
+        pRange->Next = iter->next ;
+
+        if(false == iter->expired)
+        {
+            memcpy(msg , iter->msg , MAX_MSG_SIZE);
+
+            if(NULL != pTimestamp)
+            {
+                *pTimestamp = iter->timestamp ;
+            }
+            return MailboxDynamicVerify(iter);
+        }
+        iter = iter->next ;
+    }
+
+    pRange->Next = NULL ;
+
+    return E_MAILBOXEMPTY;
+}
+
+/**
+ * @brief Find the messages whose payload matches a pattern
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pattern bytes to look for
+ * @param len number of bytes in @ref pattern
+ * @param mode @ref eMailSearch_t
+ * @param pIndices will be filled with the logical indices of the matching messages, see @ref MailboxDynamicViewAt
+ * @param maxIndices number of entries in @ref pIndices
+ * @param pFound will be updated with the number of indices written
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if nothing matched
+ * @note Nodes are not contiguous, the search kernel is run on one payload at a time
+ */
+eMailStatus_t MailboxDynamicSearch(sMailBoxDynamic_t* const Me , const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound)
 {
-    sMailNode_t* pNewsMailNode = (sMailNode_t*)malloc(sizeof(sMailNode_t));
-    assert(NULL != pNewsMailNode);
+    assert(NULL != Me);
+    assert(NULL != pFound);
 
-    memcpy(pNewsMailNode->msg , newMsg , MAX_MSG_SIZE);
-    pNewsMailNode->next = NULL ;
+    size_t found = 0 ;
+    size_t index = 0 ;
+    bool match = false ;
 
-    return pNewsMailNode ;
+    MailboxDynamicPurgeExpired(Me);
+
+    for(sMailNode_t* iter = Me->head ; (NULL != iter) && (found < maxIndices) ; iter = iter->next)
+    {
+        MailboxSearchScan(&iter->msg , 1 , pattern , len , mode , &match);
+
+        if(true == match)
+        {
+            pIndices[found++] = index ;
+        }
+        index++ ;
+    }
+    *pFound = found ;
+
+    return (0 != found) ? E_NOERROR : E_MAILBOXEMPTY ;
 }
 
 /**
- * @brief Initialization function
+ * @brief Put the message at a logical index into @ref msg without moving the current message
  * 
  * @param Me Equivalent to this pointer in cpp
- * @return eMailStatus_t status @ref eMailStatus_t
+ * @param index logical index, 0 is the oldest message
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no message at @ref index
  */
-eMailStatus_t MailboxDynamicInit(sMailBoxDynamic_t* const Me)
+eMailStatus_t MailboxDynamicViewAt(sMailBoxDynamic_t* const Me , size_t index , char* const msg)
 {
     assert(NULL != Me);
 
-    Me->head = NULL;
-    Me->CurMsgIndex  = 0;
-    Me->ActiveMsgNum = 0;
+    if(index >= Me->ActiveMsgNum)
+    {
+        return E_MAILBOXEMPTY;
+    }
 
-    return E_NOERROR;
+    sMailNode_t* iter = Me->head ;
+
+    for(size_t i = 0 ; i < index ; i++)
+    {
+        iter = iter->next ;
+    }
+    memcpy(msg , iter->msg , MAX_MSG_SIZE);
 
+    return MailboxDynamicVerify(iter);
 }
 
 /**
- * @brief Add new node , utilizes @ref MailboxDynamicNewMail
+ * @brief Add a node with a tag, see @ref MailboxDynamicReceiveTag
  * 
  * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
  * @param newmsg data for the new node
  * @return eMailStatus_t status @ref eMailStatus_t
  */
-eMailStatus_t MailboxDynamicAddMail(sMailBoxDynamic_t* const Me, const char* const newmsg)
+eMailStatus_t MailboxDynamicAddMailTagged(sMailBoxDynamic_t* const Me, uint8_t tag, const char* const newmsg)
 {
     assert(NULL != Me);
     assert(NULL != newmsg);
+    assert(tag < MAX_TAGS);
 
-    eMailStatus_t status = E_NOERROR ;
+    sMailNode_t* pMail = NULL ;
 
-    sMailNode_t* pNewsMailNode = MailboxDynamicNewMail(newmsg);
+    return MailboxDynamicAppend(Me,newmsg,tag,&pMail);
+}
 
-    sMailNode_t* iter = Me->head ;
+/**
+ * @brief Take the oldest message with a tag out of the mailbox
+ * 
+ * The oldest node of the tag is the head of its tag list, no payload is inspected
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message has the tag
+ */
+eMailStatus_t MailboxDynamicReceiveTag(sMailBoxDynamic_t* const Me , uint8_t tag , char* const msg)
+{
+    assert(NULL != Me);
+    assert(tag < MAX_TAGS);
 
-    /// If no nodes are present make the new node head 
-    if(NULL == iter)
+    MailboxDynamicPurgeExpired(Me);
+
+    sMailNode_t* pMail = Me->TagHead[tag] ;
+
+    if(NULL == pMail)
     {
-        Me->head = pNewsMailNode ;
+        return E_MAILBOXEMPTY;
     }
-    else
+
+    memcpy(msg , pMail->msg , MAX_MSG_SIZE);
+    eMailStatus_t status = MailboxDynamicVerify(pMail) ;
+    MailboxDynamicRemoveNode(Me,pMail);
+
+    return status;
+}
+
+/**
+ * @brief Delete every message with a tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message has the tag
+ */
+eMailStatus_t MailboxDynamicDeleteTag(sMailBoxDynamic_t* const Me , uint8_t tag)
+{
+    assert(NULL != Me);
+    assert(tag < MAX_TAGS);
+
+    MailboxDynamicPurgeExpired(Me);
+
+    if(NULL == Me->TagHead[tag])
     {
-        /// Append node to the end of the list
-        while(iter->next != NULL)
-        {
-            iter = iter->next ;
-        }
-        iter->next = pNewsMailNode ;
+        return E_MAILBOXEMPTY;
+    }
 
+    while(NULL != Me->TagHead[tag])
+    {
+        MailboxDynamicRemoveNode(Me , Me->TagHead[tag]);
     }
 
-    /// If number of nodes exceed predefined max nodes, then free oldest node 
-    if(Me->ActiveMsgNum >= MAX_MAILS)
+    return E_NOERROR;
+}
+
+/**
+ * @brief Add a node gathered from several fragments straight into the node, see @ref sMailFrag_t
+ * 
+ * Bytes after the last fragment are zeroed
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param frags fragments in message order
+ * @param fragNum number of fragments
+ * @return eMailStatus_t @ref E_MSGTOOLONG if the fragments do not fit in @ref MAX_MSG_SIZE
+ */
+eMailStatus_t MailboxDynamicAddMailGather(sMailBoxDynamic_t* const Me , const sMailFrag_t* const frags , size_t fragNum)
+{
+    assert(NULL != Me);
+    assert( (NULL != frags) || (0 == fragNum) );
+
+    eMailStatus_t status = E_NOERROR ;
+    sMailNode_t* pMail = NULL ;
+    size_t total = 0 ;
+
+    for(size_t i = 0 ; i < fragNum ; i++)
     {
-        iter = Me->head;
-        Me->head = Me->head->next;
-        free(iter);
-        status = E_MAILBOXOVERWRITTEN ;
+        total += frags[i].Len ;
     }
-    /// Update active message count 
-    else
+
+    if(total > MAX_MSG_SIZE)
     {
-        Me->ActiveMsgNum++;
+        return E_MSGTOOLONG;
     }
 
-    status = E_NOERROR ;
-    
-    return status;
+    status = MailboxDynamicAdmit(Me) ;
+
+    if(E_NOERROR != status)
+    {
+        return status;
+    }
+
+    /// Keep the section open until the payload is filled , readiness is reported only after that
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    status = MailboxDynamicInsert(Me,NULL,0,&pMail);
+
+    char* dst = pMail->msg ;
 
+    for(size_t i = 0 ; i < fragNum ; i++)
+    {
+        memcpy(dst , frags[i].Base , frags[i].Len);
+        dst += frags[i].Len ;
+    }
+    memset(dst , 0 , MAX_MSG_SIZE - total);
+    MailboxDynamicSeal(pMail);
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxDynamicCountChanged(Me);
+
+    return status;
 }
 
 /**
- * @brief scroll to the next message
+ * @brief Scatter the current node over several fragments , filled in order until the message or the fragments run out
  * 
- * @param Me  Equivalent to this pointer in cpp
- * @return eMailStatus_t status @ref eMailStatus_t
+ * @param Me Equivalent to this pointer in cpp
+ * @param frags destination fragments
+ * @param fragNum number of fragments
+ * @return eMailStatus_t  @ref eMailStatus_t
  */
-eMailStatus_t MailboxDynamicScrollNext(sMailBoxDynamic_t* const Me)
+eMailStatus_t MailboxDynamicviewScatter(sMailBoxDynamic_t* const Me , const sMailFrag_t* const frags , size_t fragNum)
 {
     assert(NULL != Me);
+    assert( (NULL != frags) || (0 == fragNum) );
 
-    eMailStatus_t status = E_MAILBOXEMPTY ;
+    MailboxDynamicPurgeExpired(Me);
 
-    if(1 >= Me->ActiveMsgNum)
+    if(0 == Me->ActiveMsgNum)
     {
-        Me->CurMsgIndex = 0 ;
-        status = E_MAILBOXEMPTY ;
+        return E_MAILBOXEMPTY;
     }
-    else 
+
+    if(Me->CurMsgIndex >= Me->ActiveMsgNum)
     {
-        sMailNode_t* iter = Me->head ;
+        MailboxSeqLockWriteBegin(&Me->Lock);
+        Me->CurMsgIndex = 0 ;
+        MailboxSeqLockWriteEnd(&Me->Lock);
+    }
 
-        ///Traverse to next node
+    sMailNode_t* iter = Me->head ;
+
+    for(size_t i = 0; i < Me->CurMsgIndex ; i++)
+    {
         iter = iter->next ;
-        Me->CurMsgIndex++ ;
-        
-        ///If end node is reached reset current node iterator to head node
-        if(Me->CurMsgIndex >= MAX_MAILS)
-        {
-            Me->CurMsgIndex = 0 ;
-        }
+    }
 
-        status = E_NOERROR ;
+    const char* src = iter->msg ;
+    size_t left = MAX_MSG_SIZE ;
 
+    for(size_t i = 0 ; (i < fragNum) && (0 != left) ; i++)
+    {
+        size_t len = (frags[i].Len < left) ? frags[i].Len : left ;
+
+        memcpy(frags[i].Base , src , len);
+        src += len ;
+        left -= len ;
     }
-    return status;
+
+    return MailboxDynamicVerify(iter);
 }
 
 /**
- * @brief View function displays the current message in the message box
+ * @brief Copy the current node without changing the mailbox, safe next to a writer on another thread
+ * 
+ * Retries until the copy did not overlap a change by the writer. Expired nodes not removed yet count as gone.
  * 
  * @param Me Equivalent to this pointer in cpp
  * @param msg pointer that will be filled up with the current message
- * @return eMailStatus_t status @ref eMailStatus_t
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no current message
  */
-eMailStatus_t MailboxDynamicview(sMailBoxDynamic_t* const Me , char* const msg)
+eMailStatus_t MailboxDynamicSnapshotView(sMailBoxDynamic_t const* const Me , char* const msg)
 {
     assert(NULL != Me);
 
-    eMailStatus_t status = E_NOERROR ;
-    sMailNode_t* iter = Me->head ;
+    eMailStatus_t status = E_MAILBOXEMPTY ;
+    uint32_t start = 0 ;
 
-    /// If there are no messages , set buffer to null 
-    if(0 == Me->ActiveMsgNum)
+    do
     {
-        memset(msg,0,sizeof(msg));
+        start = MailboxSeqLockReadBegin(&Me->Lock);
         status = E_MAILBOXEMPTY ;
-    }
-    
-    else
-    {
-        ///If the current index is pointing to the last node reset the index to head
-        if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+
+        /// Links may be stale until the retry check, never walk further than the mailbox can hold
+        size_t active = Me->ActiveMsgNum ;
+        size_t cur = (Me->CurMsgIndex < active) ? Me->CurMsgIndex : 0 ;
+        sMailNode_t const* iter = Me->head ;
+
+        if(active <= MAX_MAILS)
         {
-            Me->CurMsgIndex = 0 ;
+            for(size_t i = 0 ; (i < cur) && (NULL != iter) ; i++)
+            {
+                iter = iter->next ;
+            }
+
+            if( (0 != active) && (NULL != iter) && (false == iter->expired) )
+            {
+                memcpy(msg , iter->msg , MAX_MSG_SIZE);
+                status = E_NOERROR ;
+            }
         }
+    } while(true == MailboxSeqLockReadRetry(&Me->Lock , start));
 
-        /// iterate over the list until the data at the current index is obtained and copy data to @ref msg
-        for(size_t i = 0; i< Me->CurMsgIndex ; i++)
+    return status;
+}
+
+/**
+ * @brief Copy every node, oldest first, without changing the mailbox, safe next to a writer on another thread
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msgs buffer of @ref MAX_MAILS * @ref MAX_MSG_SIZE bytes, message i is at i * @ref MAX_MSG_SIZE
+ * @param pCount will be updated with the number of messages copied
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxDynamicSnapshotAll(sMailBoxDynamic_t const* const Me , char* const msgs , size_t* const pCount)
+{
+    assert(NULL != Me);
+    assert(NULL != msgs);
+    assert(NULL != pCount);
+
+    uint32_t start = 0 ;
+    size_t count = 0 ;
+
+    do
+    {
+        start = MailboxSeqLockReadBegin(&Me->Lock);
+        count = 0 ;
+
+        size_t active = Me->ActiveMsgNum ;
+        sMailNode_t const* iter = Me->head ;
+
+        for(size_t i = 0 ; (i < active) && (i < MAX_MAILS) && (NULL != iter) ; i++)
         {
+            if(false == iter->expired)
+            {
+                memcpy(&msgs[count * MAX_MSG_SIZE] , iter->msg , MAX_MSG_SIZE);
+                count++ ;
+            }
             iter = iter->next ;
         }
-        memcpy(msg,iter->msg,MAX_MSG_SIZE);
+    } while(true == MailboxSeqLockReadRetry(&Me->Lock , start));
+
+    *pCount = count ;
+
+    return (0 == count) ? E_MAILBOXEMPTY : E_NOERROR;
+}
+
+/**
+ * @brief Get a descriptor that is readable exactly while the mailbox holds messages, for use with poll or epoll
+ * 
+ * The descriptor is created on the first call, later calls return the same one
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pFd will be updated with the descriptor. Only poll it, reading it breaks the notification
+ * @return eMailStatus_t @ref E_NOTIFYUNAVAILABLE if the eventfd could not be created
+ */
+eMailStatus_t MailboxDynamicNotifyOpen(sMailBoxDynamic_t* const Me , int* const pFd)
+{
+    assert(NULL != Me);
+    assert(NULL != pFd);
+
+    if(false == MailboxEventFdOpen(&Me->Notify))
+    {
+        return E_NOTIFYUNAVAILABLE;
     }
 
-    return status;
+    MailboxDynamicCountChanged(Me);
+    *pFd = Me->Notify.Fd ;
 
+    return E_NOERROR;
 }
 
 /**
- * @brief Delete the currently viewing message
+ * @brief Close the descriptor returned by @ref MailboxDynamicNotifyOpen
  * 
  * @param Me Equivalent to this pointer in cpp
  * @return eMailStatus_t status @ref eMailStatus_t
  */
-eMailStatus_t MailboxDynamicDeleteMail(sMailBoxDynamic_t* const Me )
+eMailStatus_t MailboxDynamicNotifyClose(sMailBoxDynamic_t* const Me)
 {
     assert(NULL != Me);
 
-    eMailStatus_t status = E_NOERROR ;
+    MailboxEventFdClose(&Me->Notify);
 
-    /// If there are no messages set status to empty 
-    if(0 == Me->ActiveMsgNum )
+    return E_NOERROR;
+}
+
+/**
+ * @brief Take the oldest node out of the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxDynamicReceive(sMailBoxDynamic_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    MailboxDynamicPurgeExpired(Me);
+
+    if(NULL == Me->head)
     {
-        status = E_MAILBOXEMPTY;
+        return E_MAILBOXEMPTY;
     }
-    else
-    {
-        sMailNode_t* iter = Me->head ;
-        sMailNode_t* prevIter = iter;
-        uint8_t lCurMsgIndex = 0 ;
 
-        /// If the present message is the head node, update head node to next node 
-        if(0 == Me->CurMsgIndex)
-        {
-            prevIter = iter ;
-            iter = iter->next ;
-            Me->head = iter ;
-            free(prevIter);
-        }
-        else
+    memcpy(msg , Me->head->msg , MAX_MSG_SIZE);
+    eMailStatus_t status = MailboxDynamicVerify(Me->head) ;
+    MailboxDynamicRemoveNode(Me , Me->head);
+
+    return status;
+}
+
+/**
+ * @brief Check every node against its checksum without changing the mailbox
+ * 
+ * Only does work with @ref MAILBOX_CHECKSUM defined, otherwise nothing is ever reported corrupt
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pCorrupt will be updated with the number of corrupt nodes, may be NULL
+ * @return eMailStatus_t @ref E_MAILBOXCORRUPT if any node is corrupt
+ */
+eMailStatus_t MailboxDynamicScrub(sMailBoxDynamic_t* const Me , size_t* const pCorrupt)
+{
+    assert(NULL != Me);
+
+    size_t corrupt = 0 ;
+
+    for(sMailNode_t* iter = Me->head ; NULL != iter ; iter = iter->next)
+    {
+        if(E_NOERROR != MailboxDynamicVerify(iter))
         {
-            /// Iterate to the node to be deleted as pointed by the current index, update links and free the deleted node
-            while( (NULL != iter) && (lCurMsgIndex != Me->CurMsgIndex) )
-            {
-                ++lCurMsgIndex ;
-                prevIter = iter ;
-                iter = iter->next ;
-            }
-            ///End of the mailbox reached delete end node
-            if(NULL == iter)
-            {
-                prevIter->next = NULL ;
-                free(iter);
-            }
-            else
-            {
-                prevIter->next = iter->next ;
-                free(iter);
-            }
-            status = E_NOERROR ;
+            corrupt++ ;
         }
     }
 
-    /// Reduce the activemessage count      
-    if(Me->ActiveMsgNum > 0)
+    if(NULL != pCorrupt)
     {
-        Me->ActiveMsgNum-- ;
+        *pCorrupt = corrupt ;
     }
 
-    return status;
+    return (0 == corrupt) ? E_NOERROR : E_MAILBOXCORRUPT;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file MailBoxEventFd.c
+ * @author vishal k
+ * @brief pollable readiness file descriptor of a mailbox
+ * @date 2021-03-06
+ * @note Linux only, uses eventfd
+ * 
+ * The descriptor follows the mailbox state: it turns readable on the empty to non empty transition and
+ * is drained again on the non empty to empty transition. Adds to a mailbox that is already non empty
+ * cost no system call, so a burst of adds is signalled with a single write. The application only polls
+ * the descriptor and must not read it.
+ * 
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "MailBoxEventFd.h"
+
+/**
+ * @brief Initialization function, notification starts off
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @note Does not close a descriptor left open before, use @ref MailboxEventFdClose for that
+ */
+void MailboxEventFdInit(sMailEventFd_t* const Me)
+{
+    assert(NULL != Me);
+
+    Me->Fd = -1 ;
+    Me->Signalled = false ;
+}
+
+/**
+ * @brief Create the eventfd if it is not open yet
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return true if the descriptor is open
+ */
+bool MailboxEventFdOpen(sMailEventFd_t* const Me)
+{
+    assert(NULL != Me);
+
+    if(-1 == Me->Fd)
+    {
+        Me->Fd = eventfd(0 , EFD_NONBLOCK | EFD_CLOEXEC) ;
+        Me->Signalled = false ;
+    }
+
+    return (-1 != Me->Fd);
+}
+
+/**
+ * @brief Close the eventfd, notification is off afterwards
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxEventFdClose(sMailEventFd_t* const Me)
+{
+    assert(NULL != Me);
+
+    if(-1 != Me->Fd)
+    {
+        close(Me->Fd);
+    }
+    MailboxEventFdInit(Me);
+}
+
+/**
+ * @brief Make the descriptor follow the mailbox, called after every change of the message count
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param nonEmpty mailbox holds at least one message
+ */
+void MailboxEventFdUpdate(sMailEventFd_t* const Me , bool nonEmpty)
+{
+    uint64_t value = 1 ;
+    ssize_t ret = 0 ;
+
+    /// Nothing to do unless the state flipped, this is the common case
+    if( (-1 == Me->Fd) || (nonEmpty == Me->Signalled) )
+    {
+        return ;
+    }
+
+    /// The descriptor is non blocking, a read that finds the counter already drained fails with EAGAIN which is fine
+    if(true == nonEmpty)
+    {
+        ret = write(Me->Fd , &value , sizeof(value)) ;
+    }
+    else
+    {
+        ret = read(Me->Fd , &value , sizeof(value)) ;
+    }
+    (void)ret ;
+    Me->Signalled = nonEmpty ;
+}
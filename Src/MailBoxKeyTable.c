@@ -0,0 +1,166 @@
+/**
+ * @file MailBoxKeyTable.c
+ * @author vishal k
+ * @brief Key table used by the static and dynamic mailbox to coalesce messages with the same key
+ * @date 2021-03-06
+ * @note Linear probing with backward shift delete, so no tombstones are left behind.
+ *       The table never fills up as it has at least twice as many entries as @ref MAX_MAILS
+ * 
+ */
+
+#include <assert.h>
+#include "MailBoxKeyTable.h"
+
+/**
+ * @brief Helper function to find the home entry of a key
+ * 
+ * @param key message key
+ * @return size_t entry index
+ */
+static size_t MailboxKeyTableHash(uint32_t key)
+{
+    /// Mix high bits into the low bits used for the index
+    key ^= key >> 16 ;
+    key *= 0x45d9f3bU ;
+    key ^= key >> 16 ;
+
+    return key & (KEY_TABLE_SIZE - 1) ;
+}
+
+/**
+ * @brief Helper function that tells if an entry is in use in the current generation
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param i entry index
+ * @return true if the entry holds a key
+ */
+static bool MailboxKeyTableUsed(sMailKeyTable_t const* const Me , size_t i)
+{
+    return (NULL != Me->Entries[i].mail) && (Me->Gen == Me->Entries[i].gen) ;
+}
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxKeyTableInit(sMailKeyTable_t* const Me)
+{
+    assert(NULL != Me);
+
+    for(size_t i = 0 ; i < KEY_TABLE_SIZE ; i++)
+    {
+        Me->Entries[i].mail = NULL ;
+    }
+    Me->Gen = 0 ;
+}
+
+/**
+ * @brief Remove all keys in constant time, entries of older generations count as free
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxKeyTableClear(sMailKeyTable_t* const Me)
+{
+    assert(NULL != Me);
+
+    Me->Gen++ ;
+}
+
+/**
+ * @brief Look up the message holding @ref key
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param key message key
+ * @return void* message registered with the key, NULL if none
+ */
+void* MailboxKeyTableFind(sMailKeyTable_t const* const Me , uint32_t key)
+{
+    assert(NULL != Me);
+
+    size_t i = MailboxKeyTableHash(key);
+
+    /// Probe until the key or a free entry is found
+    while(true == MailboxKeyTableUsed(Me,i))
+    {
+        if(key == Me->Entries[i].key)
+        {
+            return Me->Entries[i].mail;
+        }
+        i = (i + 1) & (KEY_TABLE_SIZE - 1) ;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Register @ref mail as the message holding @ref key, replaces any existing entry
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param key message key
+ * @param mail message holding the key
+ */
+void MailboxKeyTableInsert(sMailKeyTable_t* const Me , uint32_t key , void* const mail)
+{
+    assert(NULL != Me);
+    assert(NULL != mail);
+
+    size_t i = MailboxKeyTableHash(key);
+
+    while( (true == MailboxKeyTableUsed(Me,i)) && (key != Me->Entries[i].key) )
+    {
+        i = (i + 1) & (KEY_TABLE_SIZE - 1) ;
+    }
+
+    Me->Entries[i].key = key ;
+    Me->Entries[i].gen = Me->Gen ;
+    Me->Entries[i].mail = mail ;
+}
+
+/**
+ * @brief Remove @ref key from the table
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param key message key
+ */
+void MailboxKeyTableRemove(sMailKeyTable_t* const Me , uint32_t key)
+{
+    assert(NULL != Me);
+
+    size_t i = MailboxKeyTableHash(key);
+
+    while( (true == MailboxKeyTableUsed(Me,i)) && (key != Me->Entries[i].key) )
+    {
+        i = (i + 1) & (KEY_TABLE_SIZE - 1) ;
+    }
+
+    if(false == MailboxKeyTableUsed(Me,i))
+    {
+        return ;
+    }
+
+    /// Shift following entries of the probe run back so lookups never stop early at the hole
+    size_t hole = i ;
+    size_t j = i ;
+
+    while(true)
+    {
+        j = (j + 1) & (KEY_TABLE_SIZE - 1) ;
+
+        if(false == MailboxKeyTableUsed(Me,j))
+        {
+            break;
+        }
+
+        size_t home = MailboxKeyTableHash(Me->Entries[j].key);
+
+        /// Move the entry only if its home is not cyclically between the hole and its current place
+        if( ((j - home) & (KEY_TABLE_SIZE - 1)) >= ((j - hole) & (KEY_TABLE_SIZE - 1)) )
+        {
+            Me->Entries[hole] = Me->Entries[j] ;
+            hole = j ;
+        }
+    }
+
+    Me->Entries[hole].mail = NULL ;
+}
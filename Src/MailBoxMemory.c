@@ -0,0 +1,217 @@
+/**
+ * @file MailBoxMemory.c
+ * @author vishal k
+ * @brief backing memory provider for large mailbox sets, huge pages and NUMA local placement
+ * @date 2021-03-06
+ * @note Linux only. NUMA placement uses the mbind system call directly so libnuma is not needed.
+ * 
+ * Huge page regions are tried as hugetlbfs pages first. Without reserved huge pages the region is mapped
+ * 2 MB aligned and advised for transparent huge pages, and if that fails regular pages are used.
+ * 
+ */
+#include <assert.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include "MailBoxMemory.h"
+
+static const size_t MAIL_MEM_ALIGN = 64 ;  //> Alignment of every allocation, one cache line
+
+/**
+ * @brief Helper function to round up to a multiple of a power of two
+ * 
+ * @param value value to round
+ * @param align power of two
+ * @return size_t rounded value
+ */
+static size_t MailboxMemoryRound(size_t value , size_t align)
+{
+    return (value + align - 1) & ~(align - 1) ;
+}
+
+/**
+ * @brief Helper function that maps a region of regular pages aligned to a huge page and advises huge pages for it
+ * 
+ * @param size region size, multiple of @ref MAIL_HUGE_PAGE_SIZE
+ * @return void* region or MAP_FAILED
+ */
+static void* MailboxMemoryMapThp(size_t size)
+{
+    /// Map one huge page more and trim, mmap only guarantees regular page alignment
+    char* raw = (char*)mmap(NULL , size + MAIL_HUGE_PAGE_SIZE , PROT_READ | PROT_WRITE , MAP_PRIVATE | MAP_ANONYMOUS , -1 , 0) ;
+
+    if(MAP_FAILED == (void*)raw)
+    {
+        return MAP_FAILED;
+    }
+
+    char* aligned = (char*)MailboxMemoryRound((size_t)raw , MAIL_HUGE_PAGE_SIZE) ;
+    size_t head = (size_t)(aligned - raw) ;
+
+    if(0 != head)
+    {
+        munmap(raw , head);
+    }
+    munmap(aligned + size , MAIL_HUGE_PAGE_SIZE - head);
+
+    if(0 != madvise(aligned , size , MADV_HUGEPAGE))
+    {
+        munmap(aligned , size);
+        return MAP_FAILED;
+    }
+
+    return aligned;
+}
+
+/**
+ * @brief Helper function that prefers the NUMA node of the calling thread for a region
+ * 
+ * @param region region start
+ * @param size region size
+ * @return true if the policy was applied
+ */
+static bool MailboxMemoryBindLocal(void* region , size_t size)
+{
+    unsigned int cpu = 0 ;
+    unsigned int node = 0 ;
+
+    if( (0 != getcpu(&cpu , &node)) || (node >= 63) )
+    {
+        return false;
+    }
+
+    unsigned long mask = 1UL << node ;
+
+    return (0 == syscall(SYS_mbind , region , size , MPOL_PREFERRED , &mask , 64 , 0));
+}
+
+/**
+ * @brief Helper function that maps a new region and makes it the current one
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param size region size, multiple of @ref MAIL_HUGE_PAGE_SIZE
+ * @return false if no memory could be mapped
+ */
+static bool MailboxMemoryGrow(sMailMemory_t* const Me , size_t size)
+{
+    void* region = MAP_FAILED ;
+
+    if(0 != (Me->Flags & E_MEM_HUGEPAGE))
+    {
+        region = mmap(NULL , size , PROT_READ | PROT_WRITE , MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB , -1 , 0) ;
+
+        if(MAP_FAILED != region)
+        {
+            Me->HugeTlbRegions++ ;
+        }
+        else
+        {
+            region = MailboxMemoryMapThp(size) ;
+            Me->ThpRegions += (MAP_FAILED != region) ? 1 : 0 ;
+        }
+    }
+
+    if(MAP_FAILED == region)
+    {
+        region = mmap(NULL , size , PROT_READ | PROT_WRITE , MAP_PRIVATE | MAP_ANONYMOUS , -1 , 0) ;
+
+        if(MAP_FAILED == region)
+        {
+            return false;
+        }
+        Me->SmallRegions++ ;
+    }
+
+    /// Policy is set before the first touch, pages are placed when they fault in
+    if( (0 != (Me->Flags & E_MEM_NUMA_LOCAL)) && (true == MailboxMemoryBindLocal(region , size)) )
+    {
+        Me->NumaRegions++ ;
+    }
+
+    sMailRegion_t* pRegion = (sMailRegion_t*)region ;
+
+    pRegion->next = Me->Regions ;
+    pRegion->size = size ;
+    Me->Regions = pRegion ;
+    Me->Cur = (char*)region + MailboxMemoryRound(sizeof(sMailRegion_t) , MAIL_MEM_ALIGN) ;
+    Me->Left = size - MailboxMemoryRound(sizeof(sMailRegion_t) , MAIL_MEM_ALIGN) ;
+
+    return true;
+}
+
+/**
+ * @brief Initialization function, no memory is mapped until the first allocation
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param regionSize size of each mapped region, rounded up to @ref MAIL_HUGE_PAGE_SIZE
+ * @param flags @ref eMailMemFlags_t
+ */
+void MailboxMemoryInit(sMailMemory_t* const Me , size_t regionSize , uint32_t flags)
+{
+    assert(NULL != Me);
+
+    Me->Flags = flags ;
+    Me->RegionSize = MailboxMemoryRound( (0 == regionSize) ? 1 : regionSize , MAIL_HUGE_PAGE_SIZE) ;
+    Me->Regions = NULL ;
+    Me->Cur = NULL ;
+    Me->Left = 0 ;
+    Me->HugeTlbRegions = 0 ;
+    Me->ThpRegions = 0 ;
+    Me->SmallRegions = 0 ;
+    Me->NumaRegions = 0 ;
+}
+
+/**
+ * @brief Unmap every region, all memory handed out becomes invalid
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxMemoryDeinit(sMailMemory_t* const Me)
+{
+    assert(NULL != Me);
+
+    while(NULL != Me->Regions)
+    {
+        sMailRegion_t* pRegion = Me->Regions ;
+
+        Me->Regions = pRegion->next ;
+        munmap(pRegion , pRegion->size);
+    }
+
+    MailboxMemoryInit(Me , Me->RegionSize , Me->Flags);
+}
+
+/**
+ * @brief Allocate zeroed memory
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param size bytes
+ * @return void* 64 byte aligned memory, NULL if no region could be mapped
+ */
+void* MailboxMemoryAlloc(sMailMemory_t* const Me , size_t size)
+{
+    assert(NULL != Me);
+
+    size = MailboxMemoryRound( (0 == size) ? 1 : size , MAIL_MEM_ALIGN) ;
+
+    if(size > Me->Left)
+    {
+        size_t regionSize = MailboxMemoryRound(size + MailboxMemoryRound(sizeof(sMailRegion_t) , MAIL_MEM_ALIGN) , MAIL_HUGE_PAGE_SIZE) ;
+
+        if(false == MailboxMemoryGrow(Me , (regionSize > Me->RegionSize) ? regionSize : Me->RegionSize))
+        {
+            return NULL;
+        }
+    }
+
+    void* p = Me->Cur ;
+
+    Me->Cur += size ;
+    Me->Left -= size ;
+
+    return p;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file MailBoxOverflow.c
+ * @author vishal k
+ * @brief what a mailbox does with a new message while it is full
+ * @date 2021-03-06
+ * 
+ * Dropping the oldest message keeps the producer running and loses data, rejecting the newest message
+ * and blocking the producer push back on it instead. Blocking needs a second thread taking messages, so
+ * every call into the mailbox must hold the lock given with the policy. The add waits on a condition
+ * variable tied to that lock until a message leaves the mailbox or the timeout runs out. An expiring
+ * message wakes it too, the add then removes the expired messages itself before checking again.
+ * 
+ */
+#include <assert.h>
+#include <time.h>
+
+#include "MailBoxOverflow.h"
+
+/**
+ * @brief Initialization function, the policy starts as @ref E_OVERFLOW_DROP_OLDEST
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxOverflowInit(sMailOverflow_t* const Me)
+{
+    assert(NULL != Me);
+
+    pthread_condattr_t attr ;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr , CLOCK_MONOTONIC);
+    pthread_cond_init(&Me->Space , &attr);
+    pthread_condattr_destroy(&attr);
+
+    Me->Policy = E_OVERFLOW_DROP_OLDEST ;
+    Me->Timeout = MAIL_WAIT_FOREVER ;
+    Me->pLock = NULL ;
+    Me->Waiters = 0 ;
+}
+
+/**
+ * @brief Destroy the condition variable, no add may be waiting on it
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxOverflowDeinit(sMailOverflow_t* const Me)
+{
+    assert(NULL != Me);
+    assert(0 == Me->Waiters);
+
+    pthread_cond_destroy(&Me->Space);
+}
+
+/**
+ * @brief Select the policy
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param policy @ref eMailOverflowPolicy_t
+ * @param timeout longest wait in nanoseconds for @ref E_OVERFLOW_BLOCK , @ref MAIL_WAIT_FOREVER for no limit
+ * @param pLock lock held around every call into the mailbox, needed for @ref E_OVERFLOW_BLOCK only
+ */
+void MailboxOverflowSet(sMailOverflow_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock)
+{
+    assert(NULL != Me);
+    assert( (E_OVERFLOW_BLOCK != policy) || (NULL != pLock) );
+
+    Me->Policy = policy ;
+    Me->Timeout = timeout ;
+    Me->pLock = pLock ;
+}
+
+/**
+ * @brief Decide whether a new message may be added , blocks according to the policy
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pCount message count of the mailbox, changed by other threads while waiting
+ * @param Reclaim removes the messages expired while waiting, called with the lock held before every check
+ * @param pOwner mailbox handed to Reclaim
+ * @return eMailStatus_t @ref E_NOERROR to add, dropping the oldest message if still full,
+ *         @ref E_MAILBOXFULL if rejected, @ref E_MAILBOXTIMEOUT if no room was made in time
+ */
+eMailStatus_t MailboxOverflowAdmit(sMailOverflow_t* const Me , const size_t* const pCount , void (*Reclaim)(void* pOwner) , void* pOwner)
+{
+    assert(NULL != Me);
+    assert(NULL != Reclaim);
+
+    if(*pCount < MAX_MAILS)
+    {
+        return E_NOERROR;
+    }
+
+    if(E_OVERFLOW_REJECT_NEWEST == Me->Policy)
+    {
+        return E_MAILBOXFULL;
+    }
+
+    if(E_OVERFLOW_BLOCK == Me->Policy)
+    {
+        struct timespec deadline ;
+
+        clock_gettime(CLOCK_MONOTONIC , &deadline);
+        if(MAIL_WAIT_FOREVER != Me->Timeout)
+        {
+            /// Whole seconds are added apart so a large timeout cannot wrap the nanoseconds
+            uint64_t ns = (uint64_t)deadline.tv_nsec + (Me->Timeout % 1000000000U) ;
+
+            deadline.tv_sec += (time_t)(Me->Timeout / 1000000000U) + (time_t)(ns / 1000000000U) ;
+            deadline.tv_nsec = (long)(ns % 1000000000U) ;
+        }
+
+        Me->Waiters++ ;
+        while(*pCount >= MAX_MAILS)
+        {
+            if(MAIL_WAIT_FOREVER == Me->Timeout)
+            {
+                pthread_cond_wait(&Me->Space , Me->pLock);
+            }
+            else if(0 != pthread_cond_timedwait(&Me->Space , Me->pLock , &deadline))
+            {
+                Reclaim(pOwner);
+                break;
+            }
+
+            /// Expiry only queues the message, take it out here so the count can drop
+            Reclaim(pOwner);
+        }
+        Me->Waiters-- ;
+
+        /// Timed out or woken together with the timeout, the count decides
+        if(*pCount >= MAX_MAILS)
+        {
+            return E_MAILBOXTIMEOUT;
+        }
+    }
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Wake blocked adds, call after every change of the message count
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param count message count after the change
+ */
+void MailboxOverflowUpdate(sMailOverflow_t* const Me , size_t count)
+{
+    assert(NULL != Me);
+
+    if( (0 != Me->Waiters) && (count < MAX_MAILS) )
+    {
+        pthread_cond_broadcast(&Me->Space);
+    }
+}
+
+/**
+ * @brief Wake blocked adds after a message expired, they remove it themselves
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxOverflowWake(sMailOverflow_t* const Me)
+{
+    assert(NULL != Me);
+
+    if(0 != Me->Waiters)
+    {
+        pthread_cond_broadcast(&Me->Space);
+    }
+}
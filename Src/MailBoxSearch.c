@@ -0,0 +1,182 @@
+/**
+ * @file MailBoxSearch.c
+ * @author vishal k
+ * @brief Payload search kernels, SSE2 and AVX2 on x86 with a scalar fallback
+ * @date 2021-03-06
+ * @note The vector kernels handle 16 byte payloads, one payload per SSE2 register and two per AVX2 register.
+ *       AVX2 is selected at run time so the build flags do not change. Other payload sizes and other
+ *       targets use the scalar kernel.
+ * 
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "MailBoxSearch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MAILBOX_SEARCH_X86
+#endif
+
+/**
+ * @brief Scalar kernel for a single payload
+ * 
+ * @param payload payload to check
+ * @param pattern pattern to look for
+ * @param len pattern length, not more than @ref MAX_MSG_SIZE
+ * @param mode @ref eMailSearch_t
+ * @return true if the payload matches
+ */
+static bool MailboxSearchScalar(const char* const payload , const char* const pattern , size_t len , eMailSearch_t mode)
+{
+    if(E_SEARCH_PREFIX == mode)
+    {
+        return (0 == memcmp(payload , pattern , len));
+    }
+
+    for(size_t k = 0 ; k + len <= MAX_MSG_SIZE ; k++)
+    {
+        if(0 == memcmp(&payload[k] , pattern , len))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#ifdef MAILBOX_SEARCH_X86
+
+/**
+ * @brief SSE2 kernel, one 16 byte payload per iteration
+ * 
+ * For contains, bit k of the accumulated mask stays set only if payload[k + j] equals pattern[j] for every j
+ */
+static void MailboxSearchSse2(const char (*payloads)[MAX_MSG_SIZE] , size_t count , const char* const pattern , size_t len , eMailSearch_t mode , bool* const pMatch)
+{
+    char padded[16] = {0};
+    memcpy(padded , pattern , len);
+
+    const __m128i vPattern = _mm_loadu_si128((const __m128i*)padded);
+    const uint32_t want = (1U << len) - 1U ;
+    const uint32_t window = (1U << (17 - len)) - 1U ;
+
+    for(size_t i = 0 ; i < count ; i++)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)payloads[i]);
+
+        if(E_SEARCH_PREFIX == mode)
+        {
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v , vPattern));
+            pMatch[i] = (want == (mask & want));
+        }
+        else
+        {
+            uint32_t acc = window ;
+
+            for(size_t j = 0 ; (j < len) && (0 != acc) ; j++)
+            {
+                acc &= (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v , _mm_set1_epi8(pattern[j]))) >> j ;
+            }
+            pMatch[i] = (0 != acc);
+        }
+    }
+}
+
+/**
+ * @brief AVX2 kernel, two 16 byte payloads per iteration
+ * 
+ * Bits shifted from the upper payload into the lower half always land outside the lower window, so both
+ * payloads can share one mask
+ */
+__attribute__((target("avx2")))
+static void MailboxSearchAvx2(const char (*payloads)[MAX_MSG_SIZE] , size_t count , const char* const pattern , size_t len , eMailSearch_t mode , bool* const pMatch)
+{
+    char padded[32] = {0};
+    memcpy(padded , pattern , len);
+    memcpy(&padded[16] , pattern , len);
+
+    const __m256i vPattern = _mm256_loadu_si256((const __m256i*)padded);
+    const uint32_t want = (1U << len) - 1U ;
+    const uint32_t window = (1U << (17 - len)) - 1U ;
+    size_t i = 0 ;
+
+    for( ; i + 2 <= count ; i += 2)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)payloads[i]);
+
+        if(E_SEARCH_PREFIX == mode)
+        {
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v , vPattern));
+            pMatch[i] = (want == (mask & want));
+            pMatch[i + 1] = (want == ((mask >> 16) & want));
+        }
+        else
+        {
+            uint32_t acc = window | (window << 16) ;
+
+            for(size_t j = 0 ; (j < len) && (0 != acc) ; j++)
+            {
+                acc &= (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v , _mm256_set1_epi8(pattern[j]))) >> j ;
+            }
+            pMatch[i] = (0 != (acc & 0xFFFFU));
+            pMatch[i + 1] = (0 != (acc >> 16));
+        }
+    }
+
+    /// Odd payload left over
+    if(i < count)
+    {
+        MailboxSearchSse2(&payloads[i] , count - i , pattern , len , mode , &pMatch[i]);
+    }
+}
+
+#endif
+
+/**
+ * @brief Check @ref count contiguous payloads against a pattern
+ * 
+ * @param payloads first payload
+ * @param count number of payloads
+ * @param pattern pattern to look for
+ * @param len pattern length, an empty pattern matches every payload
+ * @param mode @ref eMailSearch_t
+ * @param pMatch array of @ref count entries, set to true for each matching payload
+ */
+void MailboxSearchScan(const char (*payloads)[MAX_MSG_SIZE] , size_t count , const char* const pattern , size_t len , eMailSearch_t mode , bool* const pMatch)
+{
+    assert(NULL != pMatch);
+    assert( (NULL != pattern) || (0 == len) );
+
+    /// Pattern longer than a payload never matches, an empty one always does
+    if( (len > MAX_MSG_SIZE) || (0 == len) )
+    {
+        for(size_t i = 0 ; i < count ; i++)
+        {
+            pMatch[i] = (0 == len) ;
+        }
+        return ;
+    }
+
+    #ifdef MAILBOX_SEARCH_X86
+    if(16 == MAX_MSG_SIZE)
+    {
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2") ;
+
+        if(true == hasAvx2)
+        {
+            MailboxSearchAvx2(payloads , count , pattern , len , mode , pMatch);
+        }
+        else
+        {
+            MailboxSearchSse2(payloads , count , pattern , len , mode , pMatch);
+        }
+        return ;
+    }
+    #endif
+
+    for(size_t i = 0 ; i < count ; i++)
+    {
+        pMatch[i] = MailboxSearchScalar(payloads[i] , pattern , len , mode);
+    }
+}
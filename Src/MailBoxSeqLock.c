@@ -0,0 +1,92 @@
+/**
+ * @file MailBoxSeqLock.c
+ * @author vishal k
+ * @brief sequence lock letting many snapshot readers run next to the single writer of a mailbox
+ * @date 2021-03-06
+ * 
+ * The writer never waits for readers. A reader copies what it needs and retries if the writer
+ * was active during the copy. Write sections nest so helpers can open one inside another.
+ * 
+ */
+#include <assert.h>
+
+#include "MailBoxSeqLock.h"
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxSeqLockInit(sMailSeqLock_t* const Me)
+{
+    assert(NULL != Me);
+
+    __atomic_store_n(&Me->Seq , 0 , __ATOMIC_RELAXED);
+    Me->Depth = 0 ;
+}
+
+/**
+ * @brief Start changing the mailbox, readers that overlap will retry
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxSeqLockWriteBegin(sMailSeqLock_t* const Me)
+{
+    if(0 == Me->Depth++)
+    {
+        __atomic_store_n(&Me->Seq , Me->Seq + 1 , __ATOMIC_RELAXED);
+        /// Sequence turns odd before any data store becomes visible
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Done changing the mailbox, closes the section opened by @ref MailboxSeqLockWriteBegin
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+void MailboxSeqLockWriteEnd(sMailSeqLock_t* const Me)
+{
+    assert(0 != Me->Depth);
+
+    if(0 == --Me->Depth)
+    {
+        __atomic_store_n(&Me->Seq , Me->Seq + 1 , __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Start a snapshot read, waits out a write in progress
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return uint32_t sequence to pass to @ref MailboxSeqLockReadRetry
+ */
+uint32_t MailboxSeqLockReadBegin(sMailSeqLock_t const* const Me)
+{
+    uint32_t seq = __atomic_load_n(&Me->Seq , __ATOMIC_ACQUIRE) ;
+
+    while(0 != (seq & 1))
+    {
+        #if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+        #endif
+        seq = __atomic_load_n(&Me->Seq , __ATOMIC_ACQUIRE) ;
+    }
+
+    return seq;
+}
+
+/**
+ * @brief Check a snapshot read
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param start value returned by @ref MailboxSeqLockReadBegin
+ * @return true if the writer changed the mailbox during the read and the copy must be redone
+ */
+bool MailboxSeqLockReadRetry(sMailSeqLock_t const* const Me , uint32_t start)
+{
+    /// Data loads of the copy complete before the sequence is loaded again
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return (start != __atomic_load_n(&Me->Seq , __ATOMIC_RELAXED));
+}
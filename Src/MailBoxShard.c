@@ -0,0 +1,219 @@
+/**
+ * @file MailBoxShard.c
+ * @author vishal k
+ * @brief sharded mailbox, one sub-mailbox per cpu with work stealing consumers
+ * @date 2021-03-06
+ * 
+ * Producers post to the shard of the cpu they run on, so producers on different cpus never touch the
+ * same lock. Consumers drain their own shard first and then steal from the other shards, skipping
+ * shards that are empty or locked by someone else.
+ * 
+ */
+#include <assert.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "MailBoxShard.h"
+
+#ifdef USE_STATIC_MAILBOX
+#define MailboxShardBoxInit         MailboxStaticInit
+#define MailboxShardBoxDeinit       MailboxStaticDeinit
+#define MailboxShardBoxAdd          MailboxStaticAddMail
+#define MailboxShardBoxReceiveTag   MailboxStaticReceiveTag
+#else
+#define MailboxShardBoxInit         MailboxDynamicInit
+#define MailboxShardBoxDeinit       MailboxDynamicDeinit
+#define MailboxShardBoxAdd          MailboxDynamicAddMail
+#define MailboxShardBoxReceiveTag   MailboxDynamicReceiveTag
+#endif
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param shardNum number of shards, 0 for one shard per online cpu. Capped at @ref MAX_SHARDS
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxShardInit(sMailShardBox_t* const Me , size_t shardNum)
+{
+    assert(NULL != Me);
+
+    if(0 == shardNum)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN) ;
+        shardNum = (cpus > 0) ? (size_t)cpus : 1 ;
+    }
+
+    Me->ShardNum = (shardNum < MAX_SHARDS) ? shardNum : MAX_SHARDS ;
+
+    for(size_t i = 0 ; i < Me->ShardNum ; i++)
+    {
+        pthread_mutex_init(&Me->Shards[i].Lock , NULL);
+        Me->Shards[i].Count = 0 ;
+        MailboxShardBoxInit(&Me->Shards[i].Box);
+    }
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Release what @ref MailboxShardInit set up, no thread may use the mailbox anymore
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxShardDeinit(sMailShardBox_t* const Me)
+{
+    assert(NULL != Me);
+
+    for(size_t i = 0 ; i < Me->ShardNum ; i++)
+    {
+        MailboxShardBoxDeinit(&Me->Shards[i].Box);
+        pthread_mutex_destroy(&Me->Shards[i].Lock);
+    }
+    Me->ShardNum = 0 ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Shard of the cpu the caller runs on
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return size_t shard index
+ */
+size_t MailboxShardLocal(sMailShardBox_t const* const Me)
+{
+    assert(NULL != Me);
+
+    int cpu = sched_getcpu() ;
+
+    return (cpu < 0) ? 0 : ((size_t)cpu % Me->ShardNum) ;
+}
+
+/**
+ * @brief Post a message to a given shard
+ * 
+ * Unlike @ref MailboxStaticAddMail a full shard rejects the message instead of overwriting the oldest one
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param shard shard index, less than the shard count given at init
+ * @param msg message
+ * @return eMailStatus_t @ref E_MAILBOXFULL if the shard is full, retry later
+ */
+eMailStatus_t MailboxShardPostTo(sMailShardBox_t* const Me , size_t shard , const char* const msg)
+{
+    assert(NULL != Me);
+    assert(shard < Me->ShardNum);
+
+    eMailStatus_t status = E_MAILBOXFULL ;
+    sMailShard_t* pShard = &Me->Shards[shard] ;
+
+    pthread_mutex_lock(&pShard->Lock);
+
+    if(pShard->Count < MAX_MAILS)
+    {
+        status = MailboxShardBoxAdd(&pShard->Box , msg);
+        __atomic_store_n(&pShard->Count , pShard->Count + 1 , __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&pShard->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Post a message to the shard of the cpu the caller runs on
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg message
+ * @return eMailStatus_t @ref E_MAILBOXFULL if the shard is full, retry later
+ */
+eMailStatus_t MailboxShardPost(sMailShardBox_t* const Me , const char* const msg)
+{
+    return MailboxShardPostTo(Me , MailboxShardLocal(Me) , msg);
+}
+
+/**
+ * @brief Take the oldest message of a shard
+ * 
+ * Every shard message is added untagged, so the oldest message of tag 0 is the oldest message of the shard
+ * 
+ * @param pShard shard
+ * @param msg pointer that will be filled up with the message
+ * @param wait true to wait for the lock, false to give up if another thread holds it
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if nothing was taken
+ */
+static eMailStatus_t MailboxShardTake(sMailShard_t* const pShard , char* const msg , bool wait)
+{
+    eMailStatus_t status = E_MAILBOXEMPTY ;
+
+    if(0 == __atomic_load_n(&pShard->Count , __ATOMIC_RELAXED))
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    if(true == wait)
+    {
+        pthread_mutex_lock(&pShard->Lock);
+    }
+    else if(0 != pthread_mutex_trylock(&pShard->Lock))
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    status = MailboxShardBoxReceiveTag(&pShard->Box , 0 , msg);
+
+    if(E_NOERROR == status)
+    {
+        __atomic_store_n(&pShard->Count , pShard->Count - 1 , __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&pShard->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Take a message, from the home shard first and then stolen from the other shards
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param home shard drained first, less than the shard count given at init
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message was found
+ * @note Shards locked by another thread are skipped while stealing, an empty result does not prove the
+ * whole mailbox is empty
+ */
+eMailStatus_t MailboxShardReceiveFrom(sMailShardBox_t* const Me , size_t home , char* const msg)
+{
+    assert(NULL != Me);
+    assert(home < Me->ShardNum);
+
+    if(E_NOERROR == MailboxShardTake(&Me->Shards[home] , msg , true))
+    {
+        return E_NOERROR;
+    }
+
+    /// Steal, starting next to the home shard so idle consumers spread over different victims
+    for(size_t i = 1 ; i < Me->ShardNum ; i++)
+    {
+        if(E_NOERROR == MailboxShardTake(&Me->Shards[(home + i) % Me->ShardNum] , msg , false))
+        {
+            return E_NOERROR;
+        }
+    }
+
+    return E_MAILBOXEMPTY;
+}
+
+/**
+ * @brief Take a message, from the shard of the cpu the caller runs on first
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message was found
+ */
+eMailStatus_t MailboxShardReceive(sMailShardBox_t* const Me , char* const msg)
+{
+    return MailboxShardReceiveFrom(Me , MailboxShardLocal(Me) , msg);
+}
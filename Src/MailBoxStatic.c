@@ -9,10 +9,73 @@
 #include <string.h>
 #include <assert.h>
 #include "MailBoxStatic.h"
+#include "MailBoxClock.h"
+#include "MailBoxCrc.h"
 #include "UsrConfig.h"
 
 #ifdef USE_STATIC_MAILBOX
 
+/**
+ * @brief Helper function that tells if a slot holds a message of the current generation
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ * @return true if the slot holds a message, slots left over from before @ref MailboxStaticClear are free
+ */
+static bool MailboxStaticLive(sMailBox_t const* const Me , size_t slot)
+{
+    return (true == Me->Mails[slot].present) && (Me->Gen == Me->Mails[slot].gen) ;
+}
+
+/**
+ * @brief Helper function to call after every change of the message count, updates readiness and wakes blocked adds
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxStaticCountChanged(sMailBox_t* const Me)
+{
+    MailboxEventFdUpdate(&Me->Notify , 0 != Me->ActiveMsgNum);
+    MailboxOverflowUpdate(&Me->Overflow , Me->ActiveMsgNum);
+}
+
+/**
+ * @brief Helper function that stores the checksum of a slot, call after every change of its payload
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ */
+static void MailboxStaticSeal(sMailBox_t* const Me , int8_t slot)
+{
+    #ifdef MAILBOX_CHECKSUM
+    Me->Mails[slot].crc = MailboxCrc32c(Me->Msgs[slot] , MAX_MSG_SIZE) ;
+    #else
+    (void)Me;
+    (void)slot;
+    #endif
+}
+
+/**
+ * @brief Helper function that checks the payload of a slot against its checksum
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ * @return eMailStatus_t @ref E_MAILBOXCORRUPT if the payload changed since it was added
+ */
+static eMailStatus_t MailboxStaticVerify(sMailBox_t const* const Me , int8_t slot)
+{
+    #ifdef MAILBOX_CHECKSUM
+    if(Me->Mails[slot].crc != MailboxCrc32c(Me->Msgs[slot] , MAX_MSG_SIZE))
+    {
+        return E_MAILBOXCORRUPT;
+    }
+    #else
+    (void)Me;
+    (void)slot;
+    #endif
+
+    return E_NOERROR;
+}
+
 /**
  * @brief Helper function to obtain next free slot in @ref sMailBox_t
  * 
@@ -28,7 +91,7 @@ static eMailStatus_t MailboxNextSlot(sMailBox_t* Me , int8_t* pNextslot)
     for(size_t i = 0 ; i < MAX_MAILS ; i++)
     {
         /// Empty slot found, break from searching and set status to no error
-        if(false == Me->Mails[i].present)
+        if(false == MailboxStaticLive(Me,i))
         {
             *pNextslot = i ;
             status = E_NOERROR ;
@@ -67,30 +130,295 @@ static eMailStatus_t MailboxFindMSg(sMailBox_t* Me , int8_t index , int8_t* pMsg
 {
     eMailStatus_t status = E_MAILBOXEMPTY ;
 
-    /// If no active messages set status to empty
-    if(0 == Me->ActiveMsgNum)
+    /// If no message has the @ref index set status to empty
+    if( (index < 0) || ((size_t)index >= Me->ActiveMsgNum) )
     {
         status = E_MAILBOXEMPTY;
     }
     else
     {
-        /// Iterate over all possible slots and return the slot with the @ref index
-        for(size_t i = 0 ; i < MAX_MAILS ; i++)
+        /// @ref Order holds the slot of every logical index
+        *pMsgIndex = Me->Order[index];
+        status = E_NOERROR;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Helper function that gives the lowest position among the open readers
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pMinSeq will be updated with the smallest @ref sMailReader_t::NextSeq of the open readers
+ * @return true if at least one reader is open
+ */
+static bool MailboxStaticReaderMinSeq(sMailBox_t const* const Me , uint32_t* pMinSeq)
+{
+    bool found = false ;
+
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && ( (false == found) || (Me->Readers[i].NextSeq < *pMinSeq) ) )
+        {
+            *pMinSeq = Me->Readers[i].NextSeq ;
+            found = true ;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Helper function that returns the slot holding the oldest message with sequence number at or after @ref seq
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param seq Reader position to search from
+ * @param pMsgIndex will be updated with the real slot address of the message
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+static eMailStatus_t MailboxStaticFindSeq(sMailBox_t const* const Me , uint32_t seq , int8_t* pMsgIndex)
+{
+    eMailStatus_t status = E_MAILBOXEMPTY ;
+
+    /// Messages are added in sequence order, so the lowest matching sequence number is the next message for the reader
+    for(size_t i = 0 ; i < MAX_MAILS ; i++)
+    {
+        if( (true == MailboxStaticLive(Me,i)) && (Me->Mails[i].seq >= seq) )
         {
-            if( (index == Me->Mails[i].index) && (true == Me->Mails[i].present ) )
+            if( (E_NOERROR != status) || (Me->Mails[i].seq < Me->Mails[*pMsgIndex].seq) )
             {
-                
-                *pMsgIndex = i;
-                status = E_NOERROR;
-                break;
+                *pMsgIndex = i ;
+                status = E_NOERROR ;
             }
-
-        } 
+        }
     }
 
     return status;
 }
 
+/**
+ * @brief Helper function that drops the key table entry of a slot that is being freed or reused
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ */
+static void MailboxStaticReleaseKey(sMailBox_t* const Me , int8_t slot)
+{
+    if( (true == MailboxStaticLive(Me,slot)) && (true == Me->Mails[slot].keyed) )
+    {
+        MailboxKeyTableRemove(&Me->Keys , Me->Mails[slot].key);
+        Me->Mails[slot].keyed = false ;
+    }
+}
+
+/**
+ * @brief Helper function that appends a slot to the list of its tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ * @param tag message tag
+ */
+static void MailboxStaticTagLink(sMailBox_t* const Me , int8_t slot , uint8_t tag)
+{
+    Me->Mails[slot].tag = tag ;
+    Me->Mails[slot].TagNext = -1 ;
+    Me->Mails[slot].TagPrev = Me->TagTail[tag] ;
+
+    if(-1 == Me->TagTail[tag])
+    {
+        Me->TagHead[tag] = slot ;
+    }
+    else
+    {
+        Me->Mails[Me->TagTail[tag]].TagNext = slot ;
+    }
+    Me->TagTail[tag] = slot ;
+}
+
+/**
+ * @brief Helper function that takes a slot that is being freed or reused out of the list of its tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index of a present message
+ */
+static void MailboxStaticTagUnlink(sMailBox_t* const Me , int8_t slot)
+{
+    sMail_t* pMail = &Me->Mails[slot] ;
+
+    if(-1 == pMail->TagPrev)
+    {
+        Me->TagHead[pMail->tag] = pMail->TagNext ;
+    }
+    else
+    {
+        Me->Mails[pMail->TagPrev].TagNext = pMail->TagNext ;
+    }
+
+    if(-1 == pMail->TagNext)
+    {
+        Me->TagTail[pMail->tag] = pMail->TagPrev ;
+    }
+    else
+    {
+        Me->Mails[pMail->TagNext].TagPrev = pMail->TagPrev ;
+    }
+}
+
+/**
+ * @brief Helper function that stops the expiry timer of a slot that is being freed or reused
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index
+ */
+static void MailboxStaticStopTimer(sMailBox_t* const Me , int8_t slot)
+{
+    if(NULL != Me->Wheel)
+    {
+        MailboxTimerStop(Me->Wheel , &Me->Mails[slot].Timer);
+    }
+    Me->Mails[slot].expired = false ;
+}
+
+/**
+ * @brief Helper function that removes the message in a slot and closes the gap in the indices
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param slot real slot index of a present message
+ */
+static void MailboxStaticRemoveSlot(sMailBox_t* const Me , int8_t slot)
+{
+    int8_t index = Me->Mails[slot].index ;
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    MailboxStaticReleaseKey(Me,slot);
+    MailboxStaticTagUnlink(Me,slot);
+    MailboxStaticStopTimer(Me,slot);
+    Me->Mails[slot].present = false ;
+    #ifdef MAILBOX_SECURE_WIPE
+    memset( (Me->Msgs[slot]), 0 ,MAX_MSG_SIZE*sizeof(char));
+    #endif
+
+    /// Only the newer messages move down
+    for(size_t i = index + 1 ; i < Me->ActiveMsgNum ; i++)
+    {
+        Me->Mails[Me->Order[i]].index-- ;
+    }
+    memmove(&Me->Order[index] , &Me->Order[index + 1] , (Me->ActiveMsgNum - 1 - index) * sizeof(Me->Order[0]));
+
+    /// Keep the current message on screen the same
+    if(Me->CurMsgIndex > index)
+    {
+        Me->CurMsgIndex-- ;
+    }
+    Me->ActiveMsgNum-- ;
+
+    if(Me->CurMsgIndex >= Me->ActiveMsgNum)
+    {
+        Me->CurMsgIndex = 0 ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxStaticCountChanged(Me);
+}
+
+/**
+ * @brief Helper function that removes the messages whose timer fired since the last call
+ * 
+ * Only the slots queued by @ref MailboxStaticTimerExpired are visited. A queued slot that was removed
+ * meanwhile has its expired flag cleared and is skipped.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxStaticPurgeExpired(sMailBox_t* const Me)
+{
+    while(-1 != Me->ExpiredHead)
+    {
+        int8_t slot = Me->ExpiredHead ;
+
+        Me->ExpiredHead = Me->Mails[slot].ExpiredNext ;
+
+        if( (true == MailboxStaticLive(Me,slot)) && (true == Me->Mails[slot].expired) )
+        {
+            MailboxStaticRemoveSlot(Me,slot);
+        }
+    }
+}
+
+/**
+ * @brief Timer callback, marks the message as expired and queues it. It is removed on the next call into the mailbox
+ *        or by an add blocked on the full mailbox, which is woken
+ * 
+ * @param pTimer timer embedded in @ref sMail_t
+ */
+static void MailboxStaticTimerExpired(sMailTimer_t* const pTimer)
+{
+    sMailBox_t* Me = (sMailBox_t*)pTimer->owner ;
+    sMail_t* pMail = (sMail_t*)((char*)pTimer - offsetof(sMail_t , Timer)) ;
+
+    /// Timers of slots freed by @ref MailboxStaticClear are left running, ignore them
+    if(true == MailboxStaticLive(Me , pMail - Me->Mails))
+    {
+        MailboxSeqLockWriteBegin(&Me->Lock);
+        pMail->expired = true ;
+        MailboxSeqLockWriteEnd(&Me->Lock);
+        pMail->ExpiredNext = Me->ExpiredHead ;
+        Me->ExpiredHead = (int8_t)(pMail - Me->Mails) ;
+        Me->ExpiredNum++ ;
+        MailboxOverflowWake(&Me->Overflow);
+    }
+}
+
+/**
+ * @brief Helper function for @ref MailboxOverflowAdmit , removes the messages expired while an add waits
+ * 
+ * @param pOwner mailbox , @ref sMailBox_t
+ */
+static void MailboxStaticReclaimExpired(void* pOwner)
+{
+    MailboxStaticPurgeExpired((sMailBox_t*)pOwner);
+}
+
+/**
+ * @brief Helper function that frees the oldest messages once every open reader has passed them
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ */
+static void MailboxStaticReclaim(sMailBox_t* const Me)
+{
+    uint32_t minSeq = 0 ;
+    int8_t oldest = 0 ;
+
+    if(false == MailboxStaticReaderMinSeq(Me,&minSeq))
+    {
+        return ;
+    }
+
+    /// Free the message with index 0 while it is older than the slowest reader
+    while( (E_NOERROR == MailboxFindMSg(Me,0,&oldest)) && (Me->Mails[oldest].seq < minSeq) )
+    {
+        MailboxStaticRemoveSlot(Me,oldest);
+    }
+}
+
+/**
+ * @brief Helper function that tells if any open reader has already passed a message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param seq sequence number of the message
+ * @return true if at least one open reader is past the message
+ */
+static bool MailboxStaticReaderPassed(sMailBox_t const* const Me , uint32_t seq)
+{
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && (Me->Readers[i].NextSeq > seq) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * @brief Initialization function
  * 
@@ -101,6 +429,9 @@ eMailStatus_t MailboxStaticInit(sMailBox_t* const Me)
 {
     assert(NULL != Me);
 
+    MailboxSeqLockInit(&Me->Lock);
+    MailboxEventFdInit(&Me->Notify);
+    MailboxOverflowInit(&Me->Overflow);
     Me->ActiveMsgNum = 0;
 
     /// Iterate over all possible slots and init all @ref Mails params
@@ -108,9 +439,101 @@ eMailStatus_t MailboxStaticInit(sMailBox_t* const Me)
     {
         Me->Mails[i].present = false ;
         Me->Mails[i].index = 0;
+        Me->Mails[i].keyed = false ;
+        Me->Mails[i].gen = 0 ;
+        Me->Mails[i].expired = false ;
+        Me->Mails[i].ExpiredNext = -1 ;
+        MailboxTimerInit(&Me->Mails[i].Timer , Me , MailboxStaticTimerExpired);
         Me->CurMsgIndex = 0 ;
-        memset( (Me->Mails[i].msg), 0 ,MAX_MSG_SIZE*sizeof(char));
+        #ifdef MAILBOX_SECURE_WIPE
+        memset( (Me->Msgs[i]), 0 ,MAX_MSG_SIZE*sizeof(char));
+        #endif
+    }
+    Me->Gen = 0 ;
+    Me->Wheel = NULL ;
+    Me->ExpiredHead = -1 ;
+    Me->ExpiredNum = 0 ;
+
+    for(size_t i = 0 ; i < MAX_TAGS ; i++)
+    {
+        Me->TagHead[i] = -1 ;
+        Me->TagTail[i] = -1 ;
+    }
+
+    /// Close all readers and restart sequence numbering
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        Me->Readers[i].active = false ;
+        Me->Readers[i].NextSeq = 0 ;
+    }
+    Me->NextSeq = 0 ;
+    Me->LapPolicy = E_LAP_OVERWRITE ;
+    MailboxKeyTableInit(&Me->Keys);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Remove all messages in constant time
+ * 
+ * Slots are not touched, bumping the mailbox generation makes every slot free. Readers stay open and
+ * continue with the messages added after the clear.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ * @note With @ref MAILBOX_SECURE_WIPE the payloads are zeroed as well, which makes the clear linear
+ */
+eMailStatus_t MailboxStaticClear(sMailBox_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
+    #ifdef MAILBOX_SECURE_WIPE
+    for(size_t i = 0 ; i < MAX_MAILS ; i++)
+    {
+        memset( (Me->Msgs[i]), 0 ,MAX_MSG_SIZE*sizeof(char));
+    }
+    #endif
+
+    Me->Gen++ ;
+    Me->ActiveMsgNum = 0 ;
+    Me->CurMsgIndex = 0 ;
+    Me->ExpiredHead = -1 ;
+    MailboxKeyTableClear(&Me->Keys);
+
+    for(size_t i = 0 ; i < MAX_TAGS ; i++)
+    {
+        Me->TagHead[i] = -1 ;
+        Me->TagTail[i] = -1 ;
+    }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxStaticCountChanged(Me);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Release what @ref MailboxStaticInit set up
+ * 
+ * Stops the expiry timers, closes the readiness descriptor and destroys the overflow condition variable.
+ * Call it before the mailbox is initialized again or goes away, no add may be blocked in it.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticDeinit(sMailBox_t* const Me)
+{
+    assert(NULL != Me);
+
+    /// Slots freed by @ref MailboxStaticClear may still have a timer running
+    for(size_t i = 0 ; i < MAX_MAILS ; i++)
+    {
+        MailboxStaticStopTimer(Me,i);
     }
+    MailboxEventFdClose(&Me->Notify);
+    MailboxOverflowDeinit(&Me->Overflow);
+
     return E_NOERROR;
 }
 
@@ -127,16 +550,25 @@ eMailStatus_t MailboxStaticDeleteMail(sMailBox_t* const Me)
     eMailStatus_t status = E_MAILBOXEMPTY ;
     uint8_t lCurMsgIndex = 0;
 
+    MailboxStaticPurgeExpired(Me);
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
     /// Iterate over all slots, look for @ref Mails with index matching current message index
     for(size_t i = 0 ; i < MAX_MAILS ; i++)
     {
-        if( (Me->CurMsgIndex == Me->Mails[i].index ) && (true == Me->Mails[i].present))
+        if( (Me->CurMsgIndex == Me->Mails[i].index ) && (true == MailboxStaticLive(Me,i)))
         {
             /// @ref Mails found, clear the slot and set active @ref present status to false
+            MailboxStaticReleaseKey(Me,i);
+            MailboxStaticTagUnlink(Me,i);
+            MailboxStaticStopTimer(Me,i);
             Me->Mails[i].present = false ;
             lCurMsgIndex = Me->Mails[i].index ;
             Me->Mails[i].index = 0;
-            memset( (Me->Mails[i].msg), 0 ,MAX_MSG_SIZE*sizeof(char));
+            memmove(&Me->Order[lCurMsgIndex] , &Me->Order[lCurMsgIndex + 1] , (Me->ActiveMsgNum - 1 - lCurMsgIndex) * sizeof(Me->Order[0]));
+            #ifdef MAILBOX_SECURE_WIPE
+            memset( (Me->Msgs[i]), 0 ,MAX_MSG_SIZE*sizeof(char));
+            #endif
             break;
         }
     }
@@ -144,7 +576,7 @@ eMailStatus_t MailboxStaticDeleteMail(sMailBox_t* const Me)
     /// Update the indices of all slots with index value greater than deleted message
     for(size_t i = 0 ; i < MAX_MAILS ; i++)
     {
-        if( (true == Me->Mails[i].present) && (Me->Mails[i].index > lCurMsgIndex) )
+        if( (true == MailboxStaticLive(Me,i)) && (Me->Mails[i].index > lCurMsgIndex) )
         {
             Me->Mails[i].index-- ;
         }
@@ -162,24 +594,59 @@ eMailStatus_t MailboxStaticDeleteMail(sMailBox_t* const Me)
         Me->ActiveMsgNum-- ;
         status = E_NOERROR ;
     }
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxStaticCountChanged(Me);
 
     return status;
 }
 
 /**
- * @brief Add new message to mailbox
+ * @brief Helper function that decides whether a new message may be added
+ * 
+ * Runs before any write section is opened since a blocking overflow policy releases the caller's lock
+ * while it waits.
  * 
  * @param Me Equivalent to this pointer in cpp
- * @param newMsg 
- * @return eMailStatus_t 
+ * @return eMailStatus_t @ref E_NOERROR if the message may be added
  */
-eMailStatus_t MailboxStaticAddMail(sMailBox_t* const Me , const char* newMsg)
+static eMailStatus_t MailboxStaticAdmit(sMailBox_t* const Me)
 {
-    assert(NULL != Me);
+    int8_t nextSlot = 0;
+    uint32_t minSeq = 0;
 
+    /// Expired messages make room before anything gets overwritten
+    MailboxStaticPurgeExpired(Me);
+
+    /// Oldest message is still unread by a reader, reject the new message if lapping is not allowed
+    if( (Me->ActiveMsgNum >= MAX_MAILS) && (E_LAP_REJECT == Me->LapPolicy) && (true == MailboxStaticReaderMinSeq(Me,&minSeq)) )
+    {
+        if( (E_NOERROR == MailboxFindMSg(Me,0,&nextSlot)) && (Me->Mails[nextSlot].seq >= minSeq) )
+        {
+            return E_MAILBOXFULL;
+        }
+    }
+
+    /// Full mailbox, the overflow policy decides between dropping the oldest, rejecting and waiting
+    return MailboxOverflowAdmit(&Me->Overflow , &Me->ActiveMsgNum , MailboxStaticReclaimExpired , Me);
+}
+
+/**
+ * @brief Helper function that inserts an admitted message as the newest message
+ * 
+ * The caller reports the count change once the payload is in place.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newMsg message , NULL leaves filling the payload to the caller
+ * @param tag message tag
+ * @param pSlot will be updated with the real slot the message was copied to
+ * @return eMailStatus_t @ref E_MAILBOXOVERWRITTEN if the oldest message was dropped for it
+ */
+static eMailStatus_t MailboxStaticInsert(sMailBox_t* const Me , const char* newMsg , uint8_t tag , int8_t* pSlot)
+{
     eMailStatus_t status = E_MAILBOXOVERWRITTEN ;
     int8_t nextSlot = 0;
 
+    MailboxSeqLockWriteBegin(&Me->Lock);
     status = MailboxNextSlot(Me,&nextSlot);
 
     /// if empty slot obtained from @ref MailboxNextSlot increase msg number
@@ -190,27 +657,165 @@ eMailStatus_t MailboxStaticAddMail(sMailBox_t* const Me , const char* newMsg)
     }
     else
     {
+        MailboxStaticReleaseKey(Me,nextSlot);
+        MailboxStaticTagUnlink(Me,nextSlot);
+
         /// No empty slot, replace the msg with index 0 
         for(size_t i = 0 ; i < MAX_MAILS ; i++)
         {
-            if( (true == Me->Mails[i].present) && (0 != Me->Mails[i].index ) )
+            if( (true == MailboxStaticLive(Me,i)) && (0 != Me->Mails[i].index ) )
             {
                 Me->Mails[i].index-- ;
             }
         }
+        memmove(&Me->Order[0] , &Me->Order[1] , (Me->ActiveMsgNum - 1) * sizeof(Me->Order[0]));
         
     }
     
     /// Copy message to the acquired slot and set its index to messagenum-1
     /// This ensures that the older messages have lower indices
-    memcpy(Me->Mails[nextSlot].msg , newMsg , MAX_MSG_SIZE);
-    Me->Mails[nextSlot].present = true ;
+    MailboxStaticStopTimer(Me,nextSlot);
+    if(NULL != newMsg)
+    {
+        memcpy(Me->Msgs[nextSlot] , newMsg , MAX_MSG_SIZE);
+        MailboxStaticSeal(Me,nextSlot);
+    }
+    Me->Mails[nextSlot].present = true ;
+    Me->Mails[nextSlot].gen = Me->Gen ;
     Me->Mails[nextSlot].index = Me->ActiveMsgNum-1 ;  
+    Me->Mails[nextSlot].seq = Me->NextSeq++ ;
+    Me->Mails[nextSlot].timestamp = MailboxClockNow() ;
+    Me->Order[Me->ActiveMsgNum-1] = nextSlot ;
+    MailboxStaticTagLink(Me,nextSlot,tag);
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    *pSlot = nextSlot ;
 
     return status;
     
 }
 
+/**
+ * @brief Helper function that appends a message as the newest message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newMsg message
+ * @param tag message tag
+ * @param pSlot will be updated with the real slot the message was copied to , -1 if nothing was added
+ * @return eMailStatus_t @ref E_MAILBOXOVERWRITTEN if the oldest message was dropped for it
+ */
+static eMailStatus_t MailboxStaticAppend(sMailBox_t* const Me , const char* newMsg , uint8_t tag , int8_t* pSlot)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    *pSlot = -1 ;
+
+    status = MailboxStaticAdmit(Me) ;
+
+    if(E_NOERROR != status)
+    {
+        return status;
+    }
+
+    status = MailboxStaticInsert(Me,newMsg,tag,pSlot) ;
+    MailboxStaticCountChanged(Me);
+
+    return status;
+}
+
+/**
+ * @brief Add new message to mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newMsg 
+ * @return eMailStatus_t 
+ */
+eMailStatus_t MailboxStaticAddMail(sMailBox_t* const Me , const char* newMsg)
+{
+    assert(NULL != Me);
+
+    int8_t slot = 0;
+
+    return MailboxStaticAppend(Me,newMsg,0,&slot);
+}
+
+/**
+ * @brief Add a message that only matters as the latest value for its key
+ * 
+ * If a message with the same key is still pending its payload is replaced in place and it keeps its position,
+ * otherwise the message is added as the newest message. A message that an open reader has already passed
+ * is left alone and the new value is added as the newest message so that reader still gets it.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param key message key
+ * @param newMsg 
+ * @return eMailStatus_t @ref E_MAILBOXCOALESCED if a pending message was replaced
+ */
+eMailStatus_t MailboxStaticAddMailKeyed(sMailBox_t* const Me , uint32_t key , const char* newMsg)
+{
+    assert(NULL != Me);
+    assert(NULL != newMsg);
+
+    eMailStatus_t status = E_NOERROR ;
+    int8_t slot = 0;
+
+    /// An expired message must not absorb the new value , it would be purged with it
+    MailboxStaticPurgeExpired(Me);
+
+    sMail_t* pMail = (sMail_t*)MailboxKeyTableFind(&Me->Keys , key);
+
+    if(NULL != pMail)
+    {
+        if(false == MailboxStaticReaderPassed(Me , pMail->seq))
+        {
+            MailboxSeqLockWriteBegin(&Me->Lock);
+            memcpy(Me->Msgs[pMail - Me->Mails] , newMsg , MAX_MSG_SIZE);
+            MailboxStaticSeal(Me , pMail - Me->Mails);
+            MailboxSeqLockWriteEnd(&Me->Lock);
+            return E_MAILBOXCOALESCED;
+        }
+
+        /// Old value already delivered to a reader, it stays as a plain message
+        MailboxStaticReleaseKey(Me , pMail - Me->Mails);
+    }
+
+    status = MailboxStaticAppend(Me,newMsg,0,&slot);
+
+    if(-1 != slot)
+    {
+        Me->Mails[slot].keyed = true ;
+        Me->Mails[slot].key = key ;
+        MailboxKeyTableInsert(&Me->Keys , key , &Me->Mails[slot]);
+    }
+
+    return status;
+}
+
+
+/**
+ * @brief Add a message that is dropped if it is still in the mailbox after @ref ttl ticks
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param newMsg 
+ * @param ttl time to live in ticks of the wheel set with @ref MailboxStaticSetTimerWheel
+ * @return eMailStatus_t 
+ */
+eMailStatus_t MailboxStaticAddMailTtl(sMailBox_t* const Me , const char* newMsg , uint32_t ttl)
+{
+    assert(NULL != Me);
+    assert(NULL != Me->Wheel);
+
+    eMailStatus_t status = E_NOERROR ;
+    int8_t slot = 0;
+
+    status = MailboxStaticAppend(Me,newMsg,0,&slot);
+
+    if(-1 != slot)
+    {
+        MailboxTimerStart(Me->Wheel , &Me->Mails[slot].Timer , ttl);
+    }
+
+    return status;
+}
 
 /**
  * @brief Put the current message into @ref msg
@@ -225,6 +830,8 @@ eMailStatus_t MailboxStaticview(sMailBox_t* const Me , char* const msg)
 
     eMailStatus_t status = E_NOERROR ;
 
+    MailboxStaticPurgeExpired(Me);
+
     /// If empty update status
     if(0 == Me->ActiveMsgNum)
     {
@@ -235,10 +842,10 @@ eMailStatus_t MailboxStaticview(sMailBox_t* const Me , char* const msg)
         /// Iterate over all slots and copy msg with its @ref index as @ref CurMsgIndex to @ref msg
         for(size_t i = 0 ; i < MAX_MAILS ; i++)
         {
-            if( (Me->CurMsgIndex == Me->Mails[i].index) && (true == Me->Mails[i].present))
+            if( (Me->CurMsgIndex == Me->Mails[i].index) && (true == MailboxStaticLive(Me,i)))
             {
-                memcpy(msg , Me->Mails[i].msg, MAX_MSG_SIZE);
-                status = E_NOERROR ;
+                memcpy(msg , Me->Msgs[i], MAX_MSG_SIZE);
+                status = MailboxStaticVerify(Me,i) ;
                 break;
             }
         }
@@ -260,6 +867,9 @@ eMailStatus_t MailboxStaticScrollNext(sMailBox_t* const Me)
     eMailStatus_t status = E_MAILBOXEMPTY ;
     int8_t NextValidMsgIndex;
 
+    MailboxStaticPurgeExpired(Me);
+    MailboxSeqLockWriteBegin(&Me->Lock);
+
     // If no message or only message dont scroll and update status
     if(1 >= Me->ActiveMsgNum)
     {
@@ -286,11 +896,709 @@ eMailStatus_t MailboxStaticScrollNext(sMailBox_t* const Me)
         
 
     }
+    MailboxSeqLockWriteEnd(&Me->Lock);
 
     return status;
 }
 
-#endif
-        
+/**
+ * @brief Open a named reader positioned at the oldest message in the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param name Reader name, opening an already open name returns the same reader
+ * @param pReaderId will be updated with the id to be used with the reader functions
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticReaderOpen(sMailBox_t* const Me , const char* const name , uint8_t* const pReaderId)
+{
+    assert(NULL != Me);
+    assert(NULL != name);
+    assert(NULL != pReaderId);
+
+    eMailStatus_t status = E_READERINVALID ;
+    int8_t oldest = 0 ;
+
+    /// Reuse the reader if the name is already open
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if( (true == Me->Readers[i].active) && (0 == strncmp(Me->Readers[i].name , name , MAX_READER_NAME)) )
+        {
+            *pReaderId = i ;
+            return E_NOERROR;
+        }
+    }
+
+    for(size_t i = 0 ; i < MAX_READERS ; i++)
+    {
+        if(false == Me->Readers[i].active)
+        {
+            Me->Readers[i].active = true ;
+            strncpy(Me->Readers[i].name , name , MAX_READER_NAME - 1);
+            Me->Readers[i].name[MAX_READER_NAME - 1] = '\0' ;
+
+            /// Start from the oldest message present, or from the next message if empty
+            if(E_NOERROR == MailboxFindMSg(Me,0,&oldest))
+            {
+                Me->Readers[i].NextSeq = Me->Mails[oldest].seq ;
+            }
+            else
+            {
+                Me->Readers[i].NextSeq = Me->NextSeq ;
+            }
+
+            *pReaderId = i ;
+            status = E_NOERROR ;
+            break;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Close a reader, messages held back only by this reader are freed
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxStaticReaderOpen
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticReaderClose(sMailBox_t* const Me , uint8_t readerId)
+{
+    assert(NULL != Me);
+
+    if( (readerId >= MAX_READERS) || (false == Me->Readers[readerId].active) )
+    {
+        return E_READERINVALID;
+    }
+
+    Me->Readers[readerId].active = false ;
+    MailboxStaticReclaim(Me);
 
-   
\ No newline at end of file
+    return E_NOERROR;
+}
+
+/**
+ * @brief Put the message at the reader position into @ref msg
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxStaticReaderOpen
+ * @param msg pointer that will be filled up with the reader's current message
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticReaderview(sMailBox_t* const Me , uint8_t readerId , char* const msg)
+{
+    assert(NULL != Me);
+
+    eMailStatus_t status = E_READERINVALID ;
+    int8_t slot = 0 ;
+
+    MailboxStaticPurgeExpired(Me);
+
+    if( (readerId < MAX_READERS) && (true == Me->Readers[readerId].active) )
+    {
+        status = MailboxStaticFindSeq(Me , Me->Readers[readerId].NextSeq , &slot);
+
+        if(E_NOERROR == status)
+        {
+            memcpy(msg , Me->Msgs[slot] , MAX_MSG_SIZE);
+            status = MailboxStaticVerify(Me,slot) ;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Move the reader past its current message. Unlike @ref MailboxStaticScrollNext the reader does not wrap around
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param readerId id from @ref MailboxStaticReaderOpen
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticReaderScrollNext(sMailBox_t* const Me , uint8_t readerId)
+{
+    assert(NULL != Me);
+
+    eMailStatus_t status = E_READERINVALID ;
+    int8_t slot = 0 ;
+
+    MailboxStaticPurgeExpired(Me);
+
+    if( (readerId < MAX_READERS) && (true == Me->Readers[readerId].active) )
+    {
+        status = MailboxStaticFindSeq(Me , Me->Readers[readerId].NextSeq , &slot);
+
+        /// Step past the current message and free whatever all readers have now passed
+        if(E_NOERROR == status)
+        {
+            Me->Readers[readerId].NextSeq = Me->Mails[slot].seq + 1 ;
+            MailboxStaticReclaim(Me);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Select what add does when the oldest message is still unread by a reader
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param policy @ref eMailLapPolicy_t
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticSetLapPolicy(sMailBox_t* const Me , eMailLapPolicy_t policy)
+{
+    assert(NULL != Me);
+
+    Me->LapPolicy = policy ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Attach the timer wheel that expires messages added with @ref MailboxStaticAddMailTtl
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pWheel wheel shared with other mailboxes, set it while no message with a time to live is present
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticSetTimerWheel(sMailBox_t* const Me , sMailTimerWheel_t* const pWheel)
+{
+    assert(NULL != Me);
+
+    Me->Wheel = pWheel ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Select what an add does while the mailbox is full , see @ref eMailOverflowPolicy_t
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param policy @ref eMailOverflowPolicy_t
+ * @param timeout longest wait in nanoseconds for @ref E_OVERFLOW_BLOCK , @ref MAIL_WAIT_FOREVER for no limit
+ * @param pLock for @ref E_OVERFLOW_BLOCK only , must be held around every call into the mailbox and is released while an add waits
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticSetOverflowPolicy(sMailBox_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock)
+{
+    assert(NULL != Me);
+
+    MailboxOverflowSet(&Me->Overflow , policy , timeout , pLock);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Number of messages that expired since init
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pCount will be updated with the count
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticGetExpired(sMailBox_t* const Me , uint32_t* const pCount)
+{
+    assert(NULL != Me);
+    assert(NULL != pCount);
+
+    *pCount = Me->ExpiredNum ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Helper function that finds the first logical index whose message was added at or after @ref time
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param time timestamp to search for
+ * @return size_t logical index, @ref sMailBox_t::ActiveMsgNum if all messages are older
+ */
+static size_t MailboxStaticLowerBound(sMailBox_t const* const Me , uint64_t time)
+{
+    size_t low = 0 ;
+    size_t high = Me->ActiveMsgNum ;
+
+    /// Messages are kept in add order so their timestamps never decrease with the logical index
+    while(low < high)
+    {
+        size_t mid = low + ((high - low) / 2) ;
+
+        if(Me->Mails[Me->Order[mid]].timestamp < time)
+        {
+            low = mid + 1 ;
+        }
+        else
+        {
+            high = mid ;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Find the messages added in the time range [@ref from , @ref to) in O(log n)
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param from start of the range, @ref MailboxClockNow time base
+ * @param to end of the range, not included
+ * @param pRange will be updated with the range to walk with @ref MailboxStaticRangeNext
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message is in the range
+ */
+eMailStatus_t MailboxStaticRangeQuery(sMailBox_t* const Me , uint64_t from , uint64_t to , sMailRange_t* const pRange)
+{
+    assert(NULL != Me);
+    assert(NULL != pRange);
+
+    MailboxStaticPurgeExpired(Me);
+
+    pRange->Index = MailboxStaticLowerBound(Me , from);
+    pRange->End = MailboxStaticLowerBound(Me , to);
+    pRange->Next = NULL ;
+
+    return (pRange->Index < pRange->End) ? E_NOERROR : E_MAILBOXEMPTY ;
+}
+
+/**
+ * @brief Copy the next message of a range into @ref msg
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pRange range from @ref MailboxStaticRangeQuery
+ * @param msg pointer that will be filled up with the message
+ * @param pTimestamp will be updated with the time the message was added, may be NULL
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY once the range is done
+ */
+eMailStatus_t MailboxStaticRangeNext(sMailBox_t* const Me , sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp)
+{
+    assert(NULL != Me);
+    assert(NULL != pRange);
+
+    /// Messages that expired while the range is walked are skipped
+    while(pRange->Index < pRange->End)
+    {
+        int8_t slot = Me->Order[pRange->Index++] ;
+
+        if(false == Me->Mails[slot].expired)
+        {
+            memcpy(msg , Me->Msgs[slot] , MAX_MSG_SIZE);
+
+            if(NULL != pTimestamp)
+            {
+                *pTimestamp = Me->Mails[slot].timestamp ;
+            }
+            return MailboxStaticVerify(Me,slot);
+        }
+    }
+
+    return E_MAILBOXEMPTY;
+}
+
+/**
+ * @brief Find the messages whose payload matches a pattern
+ * 
+ * The payloads of all slots are scanned in one pass over @ref sMailBox_t::Msgs, matches are then reported oldest first
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pattern bytes to look for
+ * @param len number of bytes in @ref pattern
+ * @param mode @ref eMailSearch_t
+ * @param pIndices will be filled with the logical indices of the matching messages, see @ref MailboxStaticViewAt
+ * @param maxIndices number of entries in @ref pIndices
+ * @param pFound will be updated with the number of indices written
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if nothing matched
+ */
+eMailStatus_t MailboxStaticSearch(sMailBox_t* const Me , const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound)
+{
+    assert(NULL != Me);
+    assert(NULL != pFound);
+
+    bool match[MAX_MAILS];
+    size_t found = 0 ;
+
+    MailboxStaticPurgeExpired(Me);
+    MailboxSearchScan(Me->Msgs , MAX_MAILS , pattern , len , mode , match);
+
+    for(size_t i = 0 ; (i < Me->ActiveMsgNum) && (found < maxIndices) ; i++)
+    {
+        if(true == match[Me->Order[i]])
+        {
+            pIndices[found++] = i ;
+        }
+    }
+    *pFound = found ;
+
+    return (0 != found) ? E_NOERROR : E_MAILBOXEMPTY ;
+}
+
+/**
+ * @brief Put the message at a logical index into @ref msg without moving the current message
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param index logical index, 0 is the oldest message
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no message at @ref index
+ */
+eMailStatus_t MailboxStaticViewAt(sMailBox_t* const Me , size_t index , char* const msg)
+{
+    assert(NULL != Me);
+
+    if(index >= Me->ActiveMsgNum)
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    memcpy(msg , Me->Msgs[Me->Order[index]] , MAX_MSG_SIZE);
+
+    return MailboxStaticVerify(Me , Me->Order[index]);
+}
+
+/**
+ * @brief Add a message with a tag, see @ref MailboxStaticReceiveTag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
+ * @param newMsg 
+ * @return eMailStatus_t 
+ */
+eMailStatus_t MailboxStaticAddMailTagged(sMailBox_t* const Me , uint8_t tag , const char* newMsg)
+{
+    assert(NULL != Me);
+    assert(tag < MAX_TAGS);
+
+    int8_t slot = 0;
+
+    return MailboxStaticAppend(Me,newMsg,tag,&slot);
+}
+
+/**
+ * @brief Take the oldest message with a tag out of the mailbox
+ * 
+ * The oldest message of the tag is the head of its tag list, no slot is searched
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message has the tag
+ */
+eMailStatus_t MailboxStaticReceiveTag(sMailBox_t* const Me , uint8_t tag , char* const msg)
+{
+    assert(NULL != Me);
+    assert(tag < MAX_TAGS);
+
+    MailboxStaticPurgeExpired(Me);
+
+    int8_t slot = Me->TagHead[tag] ;
+
+    if(-1 == slot)
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    memcpy(msg , Me->Msgs[slot] , MAX_MSG_SIZE);
+    eMailStatus_t status = MailboxStaticVerify(Me,slot) ;
+    MailboxStaticRemoveSlot(Me,slot);
+
+    return status;
+}
+
+/**
+ * @brief Delete every message with a tag
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param tag message tag, less than @ref MAX_TAGS
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if no message has the tag
+ */
+eMailStatus_t MailboxStaticDeleteTag(sMailBox_t* const Me , uint8_t tag)
+{
+    assert(NULL != Me);
+    assert(tag < MAX_TAGS);
+
+    MailboxStaticPurgeExpired(Me);
+
+    if(-1 == Me->TagHead[tag])
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    while(-1 != Me->TagHead[tag])
+    {
+        MailboxStaticRemoveSlot(Me , Me->TagHead[tag]);
+    }
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Add a message gathered from several fragments straight into the slot, see @ref sMailFrag_t
+ * 
+ * Bytes after the last fragment are zeroed
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param frags fragments in message order
+ * @param fragNum number of fragments
+ * @return eMailStatus_t @ref E_MSGTOOLONG if the fragments do not fit in @ref MAX_MSG_SIZE
+ */
+eMailStatus_t MailboxStaticAddMailGather(sMailBox_t* const Me , const sMailFrag_t* const frags , size_t fragNum)
+{
+    assert(NULL != Me);
+    assert( (NULL != frags) || (0 == fragNum) );
+
+    eMailStatus_t status = E_NOERROR ;
+    int8_t slot = 0 ;
+    size_t total = 0 ;
+
+    for(size_t i = 0 ; i < fragNum ; i++)
+    {
+        total += frags[i].Len ;
+    }
+
+    if(total > MAX_MSG_SIZE)
+    {
+        return E_MSGTOOLONG;
+    }
+
+    status = MailboxStaticAdmit(Me) ;
+
+    if(E_NOERROR != status)
+    {
+        return status;
+    }
+
+    /// Keep the section open until the payload is filled , readiness is reported only after that
+    MailboxSeqLockWriteBegin(&Me->Lock);
+    status = MailboxStaticInsert(Me,NULL,0,&slot);
+
+    char* dst = Me->Msgs[slot] ;
+
+    for(size_t i = 0 ; i < fragNum ; i++)
+    {
+        memcpy(dst , frags[i].Base , frags[i].Len);
+        dst += frags[i].Len ;
+    }
+    memset(dst , 0 , MAX_MSG_SIZE - total);
+    MailboxStaticSeal(Me,slot);
+    MailboxSeqLockWriteEnd(&Me->Lock);
+    MailboxStaticCountChanged(Me);
+
+    return status;
+}
+
+/**
+ * @brief Scatter the current message over several fragments , filled in order until the message or the fragments run out
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param frags destination fragments
+ * @param fragNum number of fragments
+ * @return eMailStatus_t  @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticviewScatter(sMailBox_t* const Me , const sMailFrag_t* const frags , size_t fragNum)
+{
+    assert(NULL != Me);
+    assert( (NULL != frags) || (0 == fragNum) );
+
+    eMailStatus_t status = E_NOERROR ;
+    int8_t slot = 0 ;
+
+    MailboxStaticPurgeExpired(Me);
+
+    status = MailboxFindMSg(Me,Me->CurMsgIndex,&slot);
+
+    if(E_NOERROR == status)
+    {
+        const char* src = Me->Msgs[slot] ;
+        size_t left = MAX_MSG_SIZE ;
+
+        for(size_t i = 0 ; (i < fragNum) && (0 != left) ; i++)
+        {
+            size_t len = (frags[i].Len < left) ? frags[i].Len : left ;
+
+            memcpy(frags[i].Base , src , len);
+            src += len ;
+            left -= len ;
+        }
+        status = MailboxStaticVerify(Me,slot) ;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Copy the current message without changing the mailbox, safe next to a writer on another thread
+ * 
+ * Retries until the copy did not overlap a change by the writer. Expired messages not removed yet count as gone.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the current message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there is no current message
+ */
+eMailStatus_t MailboxStaticSnapshotView(sMailBox_t const* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    eMailStatus_t status = E_MAILBOXEMPTY ;
+    uint32_t start = 0 ;
+
+    do
+    {
+        start = MailboxSeqLockReadBegin(&Me->Lock);
+        status = E_MAILBOXEMPTY ;
+
+        /// Fields may be torn until the retry check, bound every index before use
+        size_t active = Me->ActiveMsgNum ;
+        size_t cur = (Me->CurMsgIndex < active) ? Me->CurMsgIndex : 0 ;
+
+        if( (0 != active) && (active <= MAX_MAILS) )
+        {
+            int8_t slot = Me->Order[cur] ;
+
+            if( (slot >= 0) && ((size_t)slot < MAX_MAILS) && (false == Me->Mails[slot].expired) )
+            {
+                memcpy(msg , Me->Msgs[slot] , MAX_MSG_SIZE);
+                status = E_NOERROR ;
+            }
+        }
+    } while(true == MailboxSeqLockReadRetry(&Me->Lock , start));
+
+    return status;
+}
+
+/**
+ * @brief Copy every message, oldest first, without changing the mailbox, safe next to a writer on another thread
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msgs buffer of @ref MAX_MAILS * @ref MAX_MSG_SIZE bytes, message i is at i * @ref MAX_MSG_SIZE
+ * @param pCount will be updated with the number of messages copied
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxStaticSnapshotAll(sMailBox_t const* const Me , char* const msgs , size_t* const pCount)
+{
+    assert(NULL != Me);
+    assert(NULL != msgs);
+    assert(NULL != pCount);
+
+    uint32_t start = 0 ;
+    size_t count = 0 ;
+
+    do
+    {
+        start = MailboxSeqLockReadBegin(&Me->Lock);
+        count = 0 ;
+
+        size_t active = Me->ActiveMsgNum ;
+
+        for(size_t i = 0 ; (i < active) && (i < MAX_MAILS) ; i++)
+        {
+            int8_t slot = Me->Order[i] ;
+
+            if( (slot >= 0) && ((size_t)slot < MAX_MAILS) && (false == Me->Mails[slot].expired) )
+            {
+                memcpy(&msgs[count * MAX_MSG_SIZE] , Me->Msgs[slot] , MAX_MSG_SIZE);
+                count++ ;
+            }
+        }
+    } while(true == MailboxSeqLockReadRetry(&Me->Lock , start));
+
+    *pCount = count ;
+
+    return (0 == count) ? E_MAILBOXEMPTY : E_NOERROR;
+}
+
+/**
+ * @brief Get a descriptor that is readable exactly while the mailbox holds messages, for use with poll or epoll
+ * 
+ * The descriptor is created on the first call, later calls return the same one
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pFd will be updated with the descriptor. Only poll it, reading it breaks the notification
+ * @return eMailStatus_t @ref E_NOTIFYUNAVAILABLE if the eventfd could not be created
+ */
+eMailStatus_t MailboxStaticNotifyOpen(sMailBox_t* const Me , int* const pFd)
+{
+    assert(NULL != Me);
+    assert(NULL != pFd);
+
+    if(false == MailboxEventFdOpen(&Me->Notify))
+    {
+        return E_NOTIFYUNAVAILABLE;
+    }
+
+    MailboxStaticCountChanged(Me);
+    *pFd = Me->Notify.Fd ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Close the descriptor returned by @ref MailboxStaticNotifyOpen
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxStaticNotifyClose(sMailBox_t* const Me)
+{
+    assert(NULL != Me);
+
+    MailboxEventFdClose(&Me->Notify);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Take the oldest message out of the mailbox
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t @ref E_MAILBOXEMPTY if there are no messages
+ */
+eMailStatus_t MailboxStaticReceive(sMailBox_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    int8_t slot = 0 ;
+
+    MailboxStaticPurgeExpired(Me);
+
+    if(E_NOERROR != MailboxFindMSg(Me,0,&slot))
+    {
+        return E_MAILBOXEMPTY;
+    }
+
+    memcpy(msg , Me->Msgs[slot] , MAX_MSG_SIZE);
+    eMailStatus_t status = MailboxStaticVerify(Me,slot) ;
+    MailboxStaticRemoveSlot(Me,slot);
+
+    return status;
+}
+
+/**
+ * @brief Check every message against its checksum without changing the mailbox
+ * 
+ * Only does work with @ref MAILBOX_CHECKSUM defined, otherwise nothing is ever reported corrupt
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pCorrupt will be updated with the number of corrupt messages, may be NULL
+ * @return eMailStatus_t @ref E_MAILBOXCORRUPT if any message is corrupt
+ */
+eMailStatus_t MailboxStaticScrub(sMailBox_t* const Me , size_t* const pCorrupt)
+{
+    assert(NULL != Me);
+
+    size_t corrupt = 0 ;
+
+    for(size_t i = 0 ; i < MAX_MAILS ; i++)
+    {
+        if( (true == MailboxStaticLive(Me,i)) && (E_NOERROR != MailboxStaticVerify(Me,i)) )
+        {
+            corrupt++ ;
+        }
+    }
+
+    if(NULL != pCorrupt)
+    {
+        *pCorrupt = corrupt ;
+    }
+
+    return (0 == corrupt) ? E_NOERROR : E_MAILBOXCORRUPT;
+}
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file MailBoxTimerWheel.c
+ * @author vishal k
+ * @brief Hierarchical timer wheel used to expire messages added with a time to live
+ * @date 2021-03-06
+ * @note Time is counted in ticks, the application decides what a tick is and drives the wheel
+ *       with @ref MailboxTimerWheelAdvance. Starting, stopping and firing a timer is constant time,
+ *       a timer is moved down at most @ref TIMER_WHEEL_LEVELS times before it fires.
+ * 
+ */
+
+#include <assert.h>
+#include "MailBoxTimerWheel.h"
+
+/**
+ * @brief Helper function to link a timer into the slot matching its expiry
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pTimer timer to link, must not be linked
+ */
+static void MailboxTimerWheelLink(sMailTimerWheel_t* const Me , sMailTimer_t* const pTimer)
+{
+    uint32_t delta = pTimer->expiry - Me->Now ;
+    uint32_t expiry = pTimer->expiry ;
+    size_t level = 0 ;
+
+    /// Already due timers go into the slot processed for the current tick
+    if((int32_t)delta < 0)
+    {
+        delta = 0 ;
+        expiry = Me->Now ;
+    }
+
+    /// Find the lowest level whose range covers the delta
+    while( (level < TIMER_WHEEL_LEVELS - 1) && (delta >= ((uint32_t)1 << (TIMER_WHEEL_BITS * (level + 1)))) )
+    {
+        level++ ;
+    }
+
+    /// Too far out for the top level, park it in the furthest top slot and re-queue from there
+    if( (TIMER_WHEEL_LEVELS - 1 == level) && (delta >= ((uint32_t)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))) )
+    {
+        expiry = Me->Now + ((uint32_t)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1 ;
+    }
+
+    sMailTimer_t* pHead = &Me->Slots[level][(expiry >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1)] ;
+
+    pTimer->next = pHead->next ;
+    pTimer->prev = pHead ;
+    pHead->next->prev = pTimer ;
+    pHead->next = pTimer ;
+}
+
+/**
+ * @brief Helper function to unlink a timer
+ * 
+ * @param pTimer timer to unlink, must be linked
+ */
+static void MailboxTimerWheelUnlink(sMailTimer_t* const pTimer)
+{
+    pTimer->prev->next = pTimer->next ;
+    pTimer->next->prev = pTimer->prev ;
+    pTimer->next = NULL ;
+    pTimer->prev = NULL ;
+}
+
+/**
+ * @brief Initialization function
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param now current tick
+ */
+void MailboxTimerWheelInit(sMailTimerWheel_t* const Me , uint32_t now)
+{
+    assert(NULL != Me);
+
+    for(size_t level = 0 ; level < TIMER_WHEEL_LEVELS ; level++)
+    {
+        for(size_t i = 0 ; i < TIMER_WHEEL_SLOTS ; i++)
+        {
+            Me->Slots[level][i].next = &Me->Slots[level][i] ;
+            Me->Slots[level][i].prev = &Me->Slots[level][i] ;
+        }
+    }
+
+    Me->Now = now ;
+    Me->RunningNum = 0 ;
+}
+
+/**
+ * @brief Move the wheel forward to @ref now and fire every timer that expired on the way
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param now current tick, must not be behind the last call
+ */
+void MailboxTimerWheelAdvance(sMailTimerWheel_t* const Me , uint32_t now)
+{
+    assert(NULL != Me);
+
+    while((int32_t)(now - Me->Now) > 0)
+    {
+        /// Nothing running, no slot needs to be visited
+        if(0 == Me->RunningNum)
+        {
+            Me->Now = now ;
+            break;
+        }
+
+        Me->Now++ ;
+
+        /// Every time a level wraps, move the timers of the next slot of the level above down
+        for(size_t level = 1 ; level < TIMER_WHEEL_LEVELS ; level++)
+        {
+            if(0 != (Me->Now & (((uint32_t)1 << (TIMER_WHEEL_BITS * level)) - 1)))
+            {
+                break;
+            }
+
+            sMailTimer_t* pHead = &Me->Slots[level][(Me->Now >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1)] ;
+
+            while(pHead->next != pHead)
+            {
+                sMailTimer_t* pTimer = pHead->next ;
+                MailboxTimerWheelUnlink(pTimer);
+                MailboxTimerWheelLink(Me,pTimer);
+            }
+        }
+
+        /// Fire the timers of the current slot
+        sMailTimer_t* pHead = &Me->Slots[0][Me->Now & (TIMER_WHEEL_SLOTS - 1)] ;
+
+        while(pHead->next != pHead)
+        {
+            sMailTimer_t* pTimer = pHead->next ;
+            MailboxTimerWheelUnlink(pTimer);
+            Me->RunningNum-- ;
+            pTimer->Expire(pTimer);
+        }
+    }
+}
+
+/**
+ * @brief Prepare a timer for use, the timer is not running afterwards
+ * 
+ * @param pTimer timer embedded in a message
+ * @param owner mailbox holding the message
+ * @param Expire called from @ref MailboxTimerWheelAdvance when the timer fires
+ */
+void MailboxTimerInit(sMailTimer_t* const pTimer , void* const owner , void (*Expire)(sMailTimer_t* const pTimer))
+{
+    assert(NULL != pTimer);
+
+    pTimer->next = NULL ;
+    pTimer->prev = NULL ;
+    pTimer->owner = owner ;
+    pTimer->Expire = Expire ;
+}
+
+/**
+ * @brief Start a timer, restarts it if it is already running
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pTimer timer prepared with @ref MailboxTimerInit
+ * @param ttl ticks from now until the timer fires, at least one
+ */
+void MailboxTimerStart(sMailTimerWheel_t* const Me , sMailTimer_t* const pTimer , uint32_t ttl)
+{
+    assert(NULL != Me);
+    assert(NULL != pTimer);
+
+    MailboxTimerStop(Me,pTimer);
+
+    /// The slot of the current tick has been processed already
+    pTimer->expiry = Me->Now + ((0 != ttl) ? ttl : 1) ;
+    MailboxTimerWheelLink(Me,pTimer);
+    Me->RunningNum++ ;
+}
+
+/**
+ * @brief Stop a timer, does nothing if it is not running
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pTimer timer prepared with @ref MailboxTimerInit
+ */
+void MailboxTimerStop(sMailTimerWheel_t* const Me , sMailTimer_t* const pTimer)
+{
+    assert(NULL != Me);
+    assert(NULL != pTimer);
+
+    if(NULL != pTimer->next)
+    {
+        MailboxTimerWheelUnlink(pTimer);
+        Me->RunningNum-- ;
+    }
+}
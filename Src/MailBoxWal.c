@@ -0,0 +1,700 @@
+/**
+ * @file MailBoxWal.c
+ * @author vishal k
+ * @brief durable mailbox, add and delete operations recorded in an append only log with group commit
+ * @date 2021-03-06
+ * @note Linux only, uses fdatasync
+ * 
+ * Group commit: the first caller that needs its record on disk becomes the leader. It waits up to the
+ * configured delay for other callers to add records, then writes the whole batch and syncs once. Callers
+ * arriving while the leader writes queue their records in the other buffer and the next leader takes them.
+ * Messages are identified in the log by an id instead of a slot or index, so a log replays into either
+ * backend. Compaction writes one add record per message in the mailbox to a new file and renames it over
+ * the log.
+ * 
+ */
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "MailBoxWal.h"
+#include "MailBoxCrc.h"
+
+#ifdef USE_STATIC_MAILBOX
+#define MailboxWalBoxClear          MailboxStaticClear
+#define MailboxWalBoxAdd            MailboxStaticAddMail
+#define MailboxWalBoxDelete         MailboxStaticDeleteMail
+#define MailboxWalBoxReceive        MailboxStaticReceive
+#define MailboxWalBoxview           MailboxStaticview
+#define MailboxWalBoxScrollNext     MailboxStaticScrollNext
+#define MailboxWalBoxViewAt         MailboxStaticViewAt
+#else
+#define MailboxWalBoxClear          MailboxDynamicClear
+#define MailboxWalBoxAdd            MailboxDynamicAddMail
+#define MailboxWalBoxDelete         MailboxDynamicDeleteMail
+#define MailboxWalBoxReceive        MailboxDynamicReceive
+#define MailboxWalBoxview           MailboxDynamicview
+#define MailboxWalBoxScrollNext     MailboxDynamicScrollNext
+#define MailboxWalBoxViewAt         MailboxDynamicViewAt
+#endif
+
+static const size_t MAIL_WAL_MIN_CAP = 64 ;    //> Records a batch buffer holds before it first grows
+
+/**
+ * @brief Helper function, checksum of a record
+ * 
+ * @param pRecord record
+ * @return uint32_t CRC32C of everything after @ref sMailWalRecord_t::Crc
+ */
+static uint32_t MailboxWalRecordCrc(sMailWalRecord_t const* const pRecord)
+{
+    return MailboxCrc32c(&pRecord->Op , sizeof(sMailWalRecord_t) - offsetof(sMailWalRecord_t , Op));
+}
+
+/**
+ * @brief Helper function that writes a whole buffer, retrying short writes
+ * 
+ * @param fd file
+ * @param buf data
+ * @param len bytes
+ * @return false on error
+ */
+static bool MailboxWalWriteAll(int fd , const void* buf , size_t len)
+{
+    const char* p = (const char*)buf ;
+
+    while(0 != len)
+    {
+        ssize_t done = write(fd , p , len) ;
+
+        if(done < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            return false;
+        }
+        p += done ;
+        len -= (size_t)done ;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Helper function that queues a record for the next batch
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param op @ref eMailWalOp_t
+ * @param id message id
+ * @param msg payload for @ref E_WAL_ADD , NULL otherwise
+ */
+static void MailboxWalLog(sMailWal_t* const Me , eMailWalOp_t op , uint64_t id , const char* const msg)
+{
+    if(Me->PendingNum == Me->PendingCap)
+    {
+        Me->PendingCap *= 2 ;
+        Me->Pending = (sMailWalRecord_t*)realloc(Me->Pending , Me->PendingCap * sizeof(sMailWalRecord_t));
+        assert(NULL != Me->Pending);
+    }
+
+    sMailWalRecord_t* pRecord = &Me->Pending[Me->PendingNum++] ;
+
+    memset(pRecord , 0 , sizeof(*pRecord));
+    pRecord->Op = (uint8_t)op ;
+    pRecord->Id = id ;
+    if(NULL != msg)
+    {
+        memcpy(pRecord->Msg , msg , MAX_MSG_SIZE);
+    }
+    pRecord->Crc = MailboxWalRecordCrc(pRecord) ;
+    Me->NextLsn++ ;
+
+    if(Me->PendingNum >= Me->MaxBatch)
+    {
+        pthread_cond_signal(&Me->Joined);
+    }
+}
+
+/**
+ * @brief Helper function that syncs the directory of the log so a rename survives a crash
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return false on error
+ */
+static bool MailboxWalSyncDir(sMailWal_t const* const Me)
+{
+    char dir[sizeof(Me->Path)] ;
+    const char* slash = strrchr(Me->Path , '/') ;
+
+    if(NULL == slash)
+    {
+        strcpy(dir , ".");
+    }
+    else
+    {
+        size_t len = (slash == Me->Path) ? 1 : (size_t)(slash - Me->Path) ;
+
+        memcpy(dir , Me->Path , len);
+        dir[len] = '\0' ;
+    }
+
+    int fd = open(dir , O_RDONLY | O_DIRECTORY) ;
+
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    bool ok = (0 == fsync(fd)) ;
+
+    close(fd);
+
+    return ok;
+}
+
+/**
+ * @brief Helper function that replaces the log with one add record per message in the mailbox
+ * 
+ * Called with @ref Lock held and no other sync running. The mailbox already holds the effect of every queued
+ * record, so the queue is dropped and everything logged so far counts as synced once the directory is synced.
+ * A failure before the rename keeps the old log, which is still complete, and is counted in
+ * @ref sMailWal_t::CompactFails. If only the directory sync fails the log file already is the compacted one,
+ * so it is kept open but the rename may not survive a crash and the log is marked @ref sMailWal_t::Failed.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return false on error
+ */
+static bool MailboxWalRewrite(sMailWal_t* const Me)
+{
+    char tmp[sizeof(Me->Path) + 8] ;
+    size_t count = Me->pBox->ActiveMsgNum ;
+    sMailWalRecord_t records[MAX_MAILS] ;
+
+    snprintf(tmp , sizeof(tmp) , "%s.compact" , Me->Path);
+
+    for(size_t i = 0 ; i < count ; i++)
+    {
+        memset(&records[i] , 0 , sizeof(records[i]));
+        records[i].Op = E_WAL_ADD ;
+        records[i].Id = Me->Ids[i] ;
+        /// A corrupt payload is logged as it is, the checksum of the mailbox still reports it after replay
+        MailboxWalBoxViewAt(Me->pBox , i , records[i].Msg);
+        records[i].Crc = MailboxWalRecordCrc(&records[i]) ;
+    }
+
+    int fd = open(tmp , O_RDWR | O_CREAT | O_TRUNC , 0644) ;
+
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    if( (false == MailboxWalWriteAll(fd , records , count * sizeof(sMailWalRecord_t))) || (0 != fdatasync(fd)) ||
+        (0 != rename(tmp , Me->Path)) )
+    {
+        close(fd);
+        unlink(tmp);
+        Me->CompactFails++ ;
+        return false;
+    }
+
+    /// The path names the new file from here on, whatever the directory sync says
+    bool ok = MailboxWalSyncDir(Me) ;
+
+    close(Me->Fd);
+    Me->Fd = fd ;
+    Me->LogRecords = count ;
+    Me->PendingNum = 0 ;
+
+    if(true == ok)
+    {
+        Me->SyncedLsn = Me->NextLsn ;
+    }
+    else
+    {
+        Me->Failed = true ;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Helper function that returns once every record queued so far is synced, leading the sync if nobody does
+ * 
+ * Called with @ref Lock held, the lock is released while waiting and while writing.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_LOGIOERROR if the log could not be written
+ */
+static eMailStatus_t MailboxWalCommit(sMailWal_t* const Me)
+{
+    uint64_t lsn = Me->NextLsn ;
+
+    while( (Me->SyncedLsn < lsn) && (false == Me->Failed) )
+    {
+        if(true == Me->Syncing)
+        {
+            pthread_cond_wait(&Me->Synced , &Me->Lock);
+            continue;
+        }
+
+        Me->Syncing = true ;
+
+        /// Leader, give other callers up to the delay to join the batch
+        if( (0 != Me->MaxDelay) && (Me->PendingNum < Me->MaxBatch) )
+        {
+            struct timespec deadline ;
+
+            clock_gettime(CLOCK_MONOTONIC , &deadline);
+            /// Whole seconds are added apart so a large delay cannot wrap the nanoseconds
+            uint64_t ns = (uint64_t)deadline.tv_nsec + (Me->MaxDelay % 1000000000U) ;
+            deadline.tv_sec += (time_t)(Me->MaxDelay / 1000000000U) + (time_t)(ns / 1000000000U) ;
+            deadline.tv_nsec = (long)(ns % 1000000000U) ;
+
+            while( (Me->PendingNum < Me->MaxBatch) && (0 == pthread_cond_timedwait(&Me->Joined , &Me->Lock , &deadline)) )
+            {
+            }
+        }
+
+        sMailWalRecord_t* batch = Me->Pending ;
+        size_t batchNum = Me->PendingNum ;
+        size_t batchCap = Me->PendingCap ;
+        uint64_t upto = Me->NextLsn ;
+
+        Me->Pending = Me->Writing ;
+        Me->PendingCap = Me->WritingCap ;
+        Me->PendingNum = 0 ;
+
+        /// Callers queue into the other buffer while the batch is written
+        pthread_mutex_unlock(&Me->Lock);
+        bool ok = MailboxWalWriteAll(Me->Fd , batch , batchNum * sizeof(sMailWalRecord_t)) && (0 == fdatasync(Me->Fd)) ;
+        pthread_mutex_lock(&Me->Lock);
+
+        Me->Writing = batch ;
+        Me->WritingCap = batchCap ;
+
+        if(true == ok)
+        {
+            Me->SyncedLsn = upto ;
+            Me->LogRecords += batchNum ;
+            Me->Syncs++ ;
+
+            /// A compaction failing before the rename keeps the old log and is tried again on the next sync,
+            /// a failed directory sync marks the log failed
+            if(Me->LogRecords >= Me->CompactAt)
+            {
+                MailboxWalRewrite(Me);
+            }
+        }
+
+        if(false == ok)
+        {
+            Me->Failed = true ;
+        }
+        Me->Syncing = false ;
+        pthread_cond_broadcast(&Me->Synced);
+    }
+
+    return (true == Me->Failed) ? E_LOGIOERROR : E_NOERROR;
+}
+
+/**
+ * @brief Open the log, replay it into the mailbox and start logging
+ * 
+ * The mailbox is cleared and filled with the messages the log leaves behind, oldest first. A torn record at
+ * the end of the log, left by a crash during a write, is cut off.
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param pBox initialized mailbox, from now on used through this module only
+ * @param path log file, created if missing
+ * @param maxDelay longest time in nanoseconds a sync waits for more records, 0 syncs at once
+ * @param maxBatch records that end the wait early
+ * @param compactAt log records that trigger compaction
+ * @return eMailStatus_t @ref E_LOGIOERROR if the log could not be opened or read, or was compacted without
+ *         syncing the directory
+ */
+eMailStatus_t MailboxWalOpen(sMailWal_t* const Me , sMailWalBox_t* const pBox , const char* const path , uint64_t maxDelay , size_t maxBatch , size_t compactAt)
+{
+    assert(NULL != Me);
+    assert(NULL != pBox);
+    assert(strlen(path) < sizeof(Me->Path));
+
+    struct stat st ;
+    bool created = false ;
+    int fd = open(path , O_RDWR) ;
+
+    if( (fd < 0) && (ENOENT == errno) )
+    {
+        fd = open(path , O_RDWR | O_CREAT | O_EXCL , 0644) ;
+        created = (fd >= 0) ;
+    }
+
+    strcpy(Me->Path , path);
+
+    /// The entry of a new log has to reach the disk too, fdatasync only covers the file itself
+    if( (fd < 0) || (0 != fstat(fd , &st)) || ((true == created) && (false == MailboxWalSyncDir(Me))) )
+    {
+        if(fd >= 0)
+        {
+            close(fd);
+        }
+        return E_LOGIOERROR;
+    }
+
+    size_t count = (size_t)st.st_size / sizeof(sMailWalRecord_t) ;
+    sMailWalRecord_t* records = (sMailWalRecord_t*)malloc( (count + 1) * sizeof(sMailWalRecord_t)) ;
+    size_t valid = 0 ;
+    size_t liveNum = 0 ;
+
+    assert(NULL != records);
+
+    if( (0 != count) && ((ssize_t)(count * sizeof(sMailWalRecord_t)) != pread(fd , records , count * sizeof(sMailWalRecord_t) , 0)) )
+    {
+        free(records);
+        close(fd);
+        return E_LOGIOERROR;
+    }
+
+    Me->NextId = 0 ;
+
+    /// Replay in place, the surviving add records are compacted to the front of the array
+    for(valid = 0 ; valid < count ; valid++)
+    {
+        sMailWalRecord_t record = records[valid] ;
+
+        if(record.Crc != MailboxWalRecordCrc(&record))
+        {
+            break;
+        }
+
+        if(E_WAL_ADD == record.Op)
+        {
+            records[liveNum++] = record ;
+            Me->NextId = (record.Id >= Me->NextId) ? (record.Id + 1) : Me->NextId ;
+        }
+        else if(E_WAL_DELETE == record.Op)
+        {
+            for(size_t i = 0 ; i < liveNum ; i++)
+            {
+                if(records[i].Id == record.Id)
+                {
+                    memmove(&records[i] , &records[i + 1] , (liveNum - i - 1) * sizeof(sMailWalRecord_t));
+                    liveNum-- ;
+                    break;
+                }
+            }
+        }
+        else if(E_WAL_CLEAR == record.Op)
+        {
+            liveNum = 0 ;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if( (valid != count) || (0 != (st.st_size % sizeof(sMailWalRecord_t))) )
+    {
+        if(0 != ftruncate(fd , (off_t)(valid * sizeof(sMailWalRecord_t))))
+        {
+            free(records);
+            close(fd);
+            return E_LOGIOERROR;
+        }
+    }
+    lseek(fd , 0 , SEEK_END);
+
+    /// A log written with a larger MAX_MAILS keeps its newest messages
+    size_t first = (liveNum > MAX_MAILS) ? (liveNum - MAX_MAILS) : 0 ;
+
+    MailboxWalBoxClear(pBox);
+    for(size_t i = first ; i < liveNum ; i++)
+    {
+        MailboxWalBoxAdd(pBox , records[i].Msg);
+        Me->Ids[i - first] = records[i].Id ;
+    }
+    free(records);
+
+    pthread_mutex_init(&Me->Lock , NULL);
+    pthread_condattr_t attr ;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr , CLOCK_MONOTONIC);
+    pthread_cond_init(&Me->Joined , &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&Me->Synced , NULL);
+
+    Me->pBox = pBox ;
+    Me->Fd = fd ;
+    Me->PendingCap = MAIL_WAL_MIN_CAP ;
+    Me->WritingCap = MAIL_WAL_MIN_CAP ;
+    Me->Pending = (sMailWalRecord_t*)malloc(MAIL_WAL_MIN_CAP * sizeof(sMailWalRecord_t));
+    Me->Writing = (sMailWalRecord_t*)malloc(MAIL_WAL_MIN_CAP * sizeof(sMailWalRecord_t));
+    assert( (NULL != Me->Pending) && (NULL != Me->Writing) );
+    Me->PendingNum = 0 ;
+    Me->NextLsn = 0 ;
+    Me->SyncedLsn = 0 ;
+    Me->Syncing = false ;
+    Me->Failed = false ;
+    Me->MaxDelay = maxDelay ;
+    Me->MaxBatch = (0 == maxBatch) ? 1 : maxBatch ;
+    Me->CompactAt = (compactAt <= MAX_MAILS) ? (MAX_MAILS + 1) : compactAt ;
+    Me->LogRecords = valid ;
+    Me->Syncs = 0 ;
+    Me->CompactFails = 0 ;
+
+    /// The replayed log stays usable if compacting it fails before the rename
+    if( (Me->LogRecords >= Me->CompactAt) && (false == MailboxWalRewrite(Me)) && (true == Me->Failed) )
+    {
+        MailboxWalClose(Me);
+        return E_LOGIOERROR;
+    }
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Close the log, the mailbox keeps its messages
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxWalClose(sMailWal_t* const Me)
+{
+    assert(NULL != Me);
+
+    /// Every operation waited for its sync, nothing is queued once no caller is left
+    close(Me->Fd);
+    Me->Fd = -1 ;
+    free(Me->Pending);
+    free(Me->Writing);
+    Me->Pending = NULL ;
+    Me->Writing = NULL ;
+    pthread_cond_destroy(&Me->Joined);
+    pthread_cond_destroy(&Me->Synced);
+    pthread_mutex_destroy(&Me->Lock);
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Add a message, returns once the add is on disk
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg message
+ * @return eMailStatus_t status of the mailbox add, @ref E_LOGIOERROR if it could not be logged
+ */
+eMailStatus_t MailboxWalAddMail(sMailWal_t* const Me , const char* const msg)
+{
+    assert(NULL != Me);
+    assert(NULL != msg);
+
+    pthread_mutex_lock(&Me->Lock);
+
+    eMailStatus_t status = E_LOGIOERROR ;
+
+    if(false == Me->Failed)
+    {
+        status = MailboxWalBoxAdd(Me->pBox , msg) ;
+
+        if( (E_NOERROR == status) || (E_MAILBOXOVERWRITTEN == status) )
+        {
+            /// Dropping the oldest message is logged as its delete
+            if(E_MAILBOXOVERWRITTEN == status)
+            {
+                MailboxWalLog(Me , E_WAL_DELETE , Me->Ids[0] , NULL);
+                memmove(&Me->Ids[0] , &Me->Ids[1] , (MAX_MAILS - 1) * sizeof(Me->Ids[0]));
+            }
+            Me->Ids[Me->pBox->ActiveMsgNum - 1] = Me->NextId ;
+            MailboxWalLog(Me , E_WAL_ADD , Me->NextId++ , msg);
+
+            if(E_NOERROR != MailboxWalCommit(Me))
+            {
+                status = E_LOGIOERROR ;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Delete the currently viewing message, returns once the delete is on disk
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status of the mailbox delete, @ref E_LOGIOERROR if it could not be logged
+ */
+eMailStatus_t MailboxWalDeleteMail(sMailWal_t* const Me)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+
+    eMailStatus_t status = E_LOGIOERROR ;
+    size_t count = Me->pBox->ActiveMsgNum ;
+
+    if(false == Me->Failed)
+    {
+        size_t index = (Me->pBox->CurMsgIndex < count) ? Me->pBox->CurMsgIndex : (count - 1) ;
+
+        status = MailboxWalBoxDelete(Me->pBox) ;
+
+        if( (E_NOERROR == status) && (0 != count) )
+        {
+            MailboxWalLog(Me , E_WAL_DELETE , Me->Ids[index] , NULL);
+            memmove(&Me->Ids[index] , &Me->Ids[index + 1] , (count - index - 1) * sizeof(Me->Ids[0]));
+
+            if(E_NOERROR != MailboxWalCommit(Me))
+            {
+                status = E_LOGIOERROR ;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Take the oldest message out of the mailbox, returns once the removal is on disk
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the message
+ * @return eMailStatus_t status of the mailbox receive, @ref E_LOGIOERROR if it could not be logged
+ */
+eMailStatus_t MailboxWalReceive(sMailWal_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+
+    eMailStatus_t status = E_LOGIOERROR ;
+
+    if(false == Me->Failed)
+    {
+        size_t count = Me->pBox->ActiveMsgNum ;
+
+        status = MailboxWalBoxReceive(Me->pBox , msg) ;
+
+        /// A corrupt message is removed as well
+        if(E_MAILBOXEMPTY != status)
+        {
+            MailboxWalLog(Me , E_WAL_DELETE , Me->Ids[0] , NULL);
+            memmove(&Me->Ids[0] , &Me->Ids[1] , (count - 1) * sizeof(Me->Ids[0]));
+
+            if(E_NOERROR != MailboxWalCommit(Me))
+            {
+                status = E_LOGIOERROR ;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Delete all messages, returns once the clear is on disk
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_LOGIOERROR if it could not be logged
+ */
+eMailStatus_t MailboxWalClear(sMailWal_t* const Me)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+
+    eMailStatus_t status = E_LOGIOERROR ;
+
+    if(false == Me->Failed)
+    {
+        MailboxWalBoxClear(Me->pBox);
+        MailboxWalLog(Me , E_WAL_CLEAR , 0 , NULL);
+        status = MailboxWalCommit(Me) ;
+    }
+
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Put the current message into @ref msg , nothing is logged
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @param msg pointer that will be filled up with the current message
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxWalview(sMailWal_t* const Me , char* const msg)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+    eMailStatus_t status = MailboxWalBoxview(Me->pBox , msg) ;
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief scroll to the next message , nothing is logged
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t status @ref eMailStatus_t
+ */
+eMailStatus_t MailboxWalScrollNext(sMailWal_t* const Me)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+    eMailStatus_t status = MailboxWalBoxScrollNext(Me->pBox) ;
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
+
+/**
+ * @brief Compact the log now instead of waiting for it to reach the size given at open
+ * 
+ * @param Me Equivalent to this pointer in cpp
+ * @return eMailStatus_t @ref E_LOGIOERROR if the new log could not be written, the old log is kept,
+ *         or if the directory could not be synced after the rename, every further operation then fails
+ */
+eMailStatus_t MailboxWalCompact(sMailWal_t* const Me)
+{
+    assert(NULL != Me);
+
+    pthread_mutex_lock(&Me->Lock);
+
+    while(true == Me->Syncing)
+    {
+        pthread_cond_wait(&Me->Synced , &Me->Lock);
+    }
+
+    eMailStatus_t status = E_LOGIOERROR ;
+
+    if(false == Me->Failed)
+    {
+        Me->Syncing = true ;
+        status = (true == MailboxWalRewrite(Me)) ? E_NOERROR : E_LOGIOERROR ;
+        Me->Syncing = false ;
+        pthread_cond_broadcast(&Me->Synced);
+    }
+
+    pthread_mutex_unlock(&Me->Lock);
+
+    return status;
+}
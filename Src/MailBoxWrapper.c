@@ -56,6 +56,50 @@ eMailStatus_t MailboxInit()
     return status ;
 }
 
+/**
+ * @brief wrapper deinit function around @ref MailboxStaticDeinit and @ref MailboxDynamicDeinit
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDeinit()
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticDeinit(pGMailBoxStatic) ;
+
+    #else 
+
+    status = MailboxDynamicDeinit(pgMailBoxDynamic);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper clear function around @ref MailboxStaticClear and @ref MailboxDynamicClear
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxClear()
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticClear(pGMailBoxStatic) ;
+
+    #else 
+
+    status = MailboxDynamicClear(pgMailBoxDynamic);
+
+    #endif
+
+    return status ;
+}
+
 /**
  * @brief wrapper message delete  function around @ref MailboxStaticDeleteMail and @ref MailboxDynamicDeleteMail
  * 
@@ -101,6 +145,29 @@ eMailStatus_t MailboxAddMail(const char* msg)
 
 }
 
+/**
+ * @brief wrapper coalescing add function around @ref MailboxStaticAddMailKeyed and @ref MailboxDynamicAddMailKeyed
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxAddMailKeyed(uint32_t key , const char* msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticAddMailKeyed(pGMailBoxStatic,key,msg) ;
+
+    #else 
+
+    status = MailboxDynamicAddMailKeyed(pgMailBoxDynamic,key,msg);
+
+    #endif
+
+    return status ;
+
+}
+
 /**
  * @brief wrapper scroll function around @ref MailboxStaticScrollNext and @ref MailboxDynamicScrollNext
  * 
@@ -171,6 +238,534 @@ eMailStatus_t MailboxViewAll()
 
 }
 
+/**
+ * @brief wrapper reader open function around @ref MailboxStaticReaderOpen and @ref MailboxDynamicReaderOpen
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReaderOpen(const char* name , uint8_t* const pReaderId)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReaderOpen(pGMailBoxStatic,name,pReaderId) ;
+
+    #else 
+
+    status = MailboxDynamicReaderOpen(pgMailBoxDynamic,name,pReaderId);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper reader close function around @ref MailboxStaticReaderClose and @ref MailboxDynamicReaderClose
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReaderClose(uint8_t readerId)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReaderClose(pGMailBoxStatic,readerId) ;
+
+    #else 
+
+    status = MailboxDynamicReaderClose(pgMailBoxDynamic,readerId);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper reader view function around @ref MailboxStaticReaderview and @ref MailboxDynamicReaderview
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReaderview(uint8_t readerId , char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReaderview(pGMailBoxStatic,readerId,msg) ;
+
+    #else 
+
+    status = MailboxDynamicReaderview(pgMailBoxDynamic,readerId,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper reader scroll function around @ref MailboxStaticReaderScrollNext and @ref MailboxDynamicReaderScrollNext
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReaderScrollNext(uint8_t readerId)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReaderScrollNext(pGMailBoxStatic,readerId) ;
+
+    #else 
+
+    status = MailboxDynamicReaderScrollNext(pgMailBoxDynamic,readerId);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper lap policy function around @ref MailboxStaticSetLapPolicy and @ref MailboxDynamicSetLapPolicy
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSetLapPolicy(eMailLapPolicy_t policy)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSetLapPolicy(pGMailBoxStatic,policy) ;
+
+    #else 
+
+    status = MailboxDynamicSetLapPolicy(pgMailBoxDynamic,policy);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper overflow policy function around @ref MailboxStaticSetOverflowPolicy and @ref MailboxDynamicSetOverflowPolicy
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSetOverflowPolicy(eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSetOverflowPolicy(pGMailBoxStatic,policy,timeout,pLock) ;
+
+    #else 
+
+    status = MailboxDynamicSetOverflowPolicy(pgMailBoxDynamic,policy,timeout,pLock);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper time to live add function around @ref MailboxStaticAddMailTtl and @ref MailboxDynamicAddMailTtl
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxAddMailTtl(const char* msg , uint32_t ttl)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticAddMailTtl(pGMailBoxStatic,msg,ttl) ;
+
+    #else 
+
+    status = MailboxDynamicAddMailTtl(pgMailBoxDynamic,msg,ttl);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper timer wheel function around @ref MailboxStaticSetTimerWheel and @ref MailboxDynamicSetTimerWheel
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSetTimerWheel(sMailTimerWheel_t* const pWheel)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSetTimerWheel(pGMailBoxStatic,pWheel) ;
+
+    #else 
+
+    status = MailboxDynamicSetTimerWheel(pgMailBoxDynamic,pWheel);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper expired count function around @ref MailboxStaticGetExpired and @ref MailboxDynamicGetExpired
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxGetExpired(uint32_t* const pCount)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticGetExpired(pGMailBoxStatic,pCount) ;
+
+    #else 
+
+    status = MailboxDynamicGetExpired(pgMailBoxDynamic,pCount);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper time range query function around @ref MailboxStaticRangeQuery and @ref MailboxDynamicRangeQuery
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxRangeQuery(uint64_t from , uint64_t to , sMailRange_t* const pRange)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticRangeQuery(pGMailBoxStatic,from,to,pRange) ;
+
+    #else 
+
+    status = MailboxDynamicRangeQuery(pgMailBoxDynamic,from,to,pRange);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper time range walk function around @ref MailboxStaticRangeNext and @ref MailboxDynamicRangeNext
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxRangeNext(sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticRangeNext(pGMailBoxStatic,pRange,msg,pTimestamp) ;
+
+    #else 
+
+    status = MailboxDynamicRangeNext(pgMailBoxDynamic,pRange,msg,pTimestamp);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper payload search function around @ref MailboxStaticSearch and @ref MailboxDynamicSearch
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSearch(const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSearch(pGMailBoxStatic,pattern,len,mode,pIndices,maxIndices,pFound) ;
+
+    #else 
+
+    status = MailboxDynamicSearch(pgMailBoxDynamic,pattern,len,mode,pIndices,maxIndices,pFound);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper indexed view function around @ref MailboxStaticViewAt and @ref MailboxDynamicViewAt
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxViewAt(size_t index , char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticViewAt(pGMailBoxStatic,index,msg) ;
+
+    #else 
+
+    status = MailboxDynamicViewAt(pgMailBoxDynamic,index,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper tagged add function around @ref MailboxStaticAddMailTagged and @ref MailboxDynamicAddMailTagged
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxAddMailTagged(uint8_t tag , const char* msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticAddMailTagged(pGMailBoxStatic,tag,msg) ;
+
+    #else 
+
+    status = MailboxDynamicAddMailTagged(pgMailBoxDynamic,tag,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper selective receive function around @ref MailboxStaticReceiveTag and @ref MailboxDynamicReceiveTag
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReceiveTag(uint8_t tag , char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReceiveTag(pGMailBoxStatic,tag,msg) ;
+
+    #else 
+
+    status = MailboxDynamicReceiveTag(pgMailBoxDynamic,tag,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper delete by tag function around @ref MailboxStaticDeleteTag and @ref MailboxDynamicDeleteTag
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxDeleteTag(uint8_t tag)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticDeleteTag(pGMailBoxStatic,tag) ;
+
+    #else 
+
+    status = MailboxDynamicDeleteTag(pgMailBoxDynamic,tag);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper gather add function around @ref MailboxStaticAddMailGather and @ref MailboxDynamicAddMailGather
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxAddMailGather(const sMailFrag_t* const frags , size_t fragNum)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticAddMailGather(pGMailBoxStatic,frags,fragNum) ;
+
+    #else 
+
+    status = MailboxDynamicAddMailGather(pgMailBoxDynamic,frags,fragNum);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper scatter view function around @ref MailboxStaticviewScatter and @ref MailboxDynamicviewScatter
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxviewScatter(const sMailFrag_t* const frags , size_t fragNum)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticviewScatter(pGMailBoxStatic,frags,fragNum) ;
+
+    #else 
+
+    status = MailboxDynamicviewScatter(pgMailBoxDynamic,frags,fragNum);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper snapshot view function around @ref MailboxStaticSnapshotView and @ref MailboxDynamicSnapshotView
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSnapshotView(char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSnapshotView(pGMailBoxStatic,msg) ;
+
+    #else 
+
+    status = MailboxDynamicSnapshotView(pgMailBoxDynamic,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper whole mailbox snapshot function around @ref MailboxStaticSnapshotAll and @ref MailboxDynamicSnapshotAll
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxSnapshotAll(char* const msgs , size_t* const pCount)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticSnapshotAll(pGMailBoxStatic,msgs,pCount) ;
+
+    #else 
+
+    status = MailboxDynamicSnapshotAll(pgMailBoxDynamic,msgs,pCount);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper readiness descriptor function around @ref MailboxStaticNotifyOpen and @ref MailboxDynamicNotifyOpen
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxNotifyOpen(int* const pFd)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticNotifyOpen(pGMailBoxStatic,pFd) ;
+
+    #else 
+
+    status = MailboxDynamicNotifyOpen(pgMailBoxDynamic,pFd);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper readiness descriptor close function around @ref MailboxStaticNotifyClose and @ref MailboxDynamicNotifyClose
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxNotifyClose()
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticNotifyClose(pGMailBoxStatic) ;
+
+    #else 
+
+    status = MailboxDynamicNotifyClose(pgMailBoxDynamic);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper receive function around @ref MailboxStaticReceive and @ref MailboxDynamicReceive
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxReceive(char* const msg)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticReceive(pGMailBoxStatic,msg) ;
+
+    #else 
+
+    status = MailboxDynamicReceive(pgMailBoxDynamic,msg);
+
+    #endif
+
+    return status ;
+}
+
+/**
+ * @brief wrapper checksum scrub function around @ref MailboxStaticScrub and @ref MailboxDynamicScrub
+ * 
+ * @return eMailStatus_t @ref eMailStatus_t
+ */
+eMailStatus_t MailboxScrub(size_t* const pCorrupt)
+{
+    eMailStatus_t status = E_NOERROR ;
+
+    #ifdef USE_STATIC_MAILBOX
+
+    status = MailboxStaticScrub(pGMailBoxStatic,pCorrupt) ;
+
+    #else 
+
+    status = MailboxDynamicScrub(pgMailBoxDynamic,pCorrupt);
+
+    #endif
+
+    return status ;
+}
+
 /**
  * @brief Utility function to view all messages in static mail box
  * 
@@ -193,10 +788,10 @@ static eMailStatus_t MailboxStaticViewAll(sMailBox_t const* const Me )
     {
         for(size_t i = 0 ; i < MAX_MAILS ; i++)
         {
-            if(true == Me->Mails[i].present)
+            if( (true == Me->Mails[i].present) && (Me->Gen == Me->Mails[i].gen) && (false == Me->Mails[i].expired) )
             {
                 printf("%d\t",Me->Mails[i].index);
-                puts(Me->Mails[i].msg);
+                puts(Me->Msgs[i]);
 
             }
         }
@@ -230,7 +825,10 @@ static eMailStatus_t MailboxDynamicViewAll(sMailBoxDynamic_t const* const Me )
 
         while(NULL != iter)
         {
-            printf("\n%s\n",iter->msg);
+            if(false == iter->expired)
+            {
+                printf("\n%s\n",iter->msg);
+            }
             iter = iter->next;
         }
         status = E_NOERROR;
@@ -0,0 +1,266 @@
+/**
+ * @file MailBoxLoadGen.c
+ * @author vishal k
+ * @brief Load generator for the mailbox server, reports throughput and latency
+ * @date 2021-03-06
+ * 
+ * Usage: mailbox_loadgen [socket path] [connections] [requests per connection] [pipeline depth] [batch]
+ * 
+ * Every connection opens its own mailbox and keeps up to depth requests in flight, alternating a batch
+ * add and a batch receive of the given batch size. Latency is measured from writing a request to
+ * reading its response.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "MailBoxProtocol.h"
+#include "MailBoxClock.h"
+
+static const char* gPath = MAILBOX_SOCKET_PATH ;
+static size_t gRequests = 100000 ;          /**< Requests per connection*/
+static size_t gDepth = 32 ;                 /**< Requests in flight per connection*/
+static size_t gBatch = 4 ;                  /**< Messages per add and receive*/
+
+/**
+ * @brief State of one connection
+ * 
+ */
+typedef struct
+{
+    pthread_t Thread;
+    size_t Id;
+    uint64_t* Latency;      /**< Latency of every request in ns, holds the send time until the response arrives*/
+    size_t Messages;        /**< Messages added and taken*/
+    bool Failed;
+}sLoadConn_t;
+
+/**
+ * @brief Write a whole buffer
+ * 
+ * @return false if the connection failed
+ */
+static bool LoadWrite(int fd , const void* buf , size_t len)
+{
+    const char* p = (const char*)buf ;
+
+    while(0 != len)
+    {
+        ssize_t ret = write(fd , p , len) ;
+
+        if(ret <= 0)
+        {
+            return false;
+        }
+        p += ret ;
+        len -= (size_t)ret ;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read a whole buffer
+ * 
+ * @return false if the connection failed
+ */
+static bool LoadRead(int fd , void* buf , size_t len)
+{
+    char* p = (char*)buf ;
+
+    while(0 != len)
+    {
+        ssize_t ret = read(fd , p , len) ;
+
+        if(ret <= 0)
+        {
+            return false;
+        }
+        p += ret ;
+        len -= (size_t)ret ;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Send request number @ref n , adds and receives alternate
+ * 
+ * @return false if the connection failed
+ */
+static bool LoadSend(int fd , uint16_t box , size_t n , uint64_t* pSent)
+{
+    char buf[sizeof(sMailReqHdr_t) + (MAX_BATCH * MAX_MSG_SIZE)] ;
+    sMailReqHdr_t req ;
+    size_t len = sizeof(req) ;
+
+    memset(&req , 0 , sizeof(req));
+    req.Op = (0 == (n & 1)) ? E_OP_ADD : E_OP_RECEIVE ;
+    req.Box = box ;
+    req.Count = (uint16_t)gBatch ;
+    req.Tag = (uint32_t)n ;
+
+    if(E_OP_ADD == req.Op)
+    {
+        memset(&buf[len] , (int)(n & 0xFF) , gBatch * MAX_MSG_SIZE);
+        len += gBatch * MAX_MSG_SIZE ;
+    }
+    memcpy(buf , &req , sizeof(req));
+
+    pSent[n] = MailboxClockNow() ;
+
+    return LoadWrite(fd , buf , len);
+}
+
+/**
+ * @brief Connection thread
+ * 
+ * @param arg @ref sLoadConn_t
+ * @return void* unused
+ */
+static void* LoadConn(void* arg)
+{
+    sLoadConn_t* pConn = (sLoadConn_t*)arg ;
+    struct sockaddr_un addr ;
+    char name[MAX_BOX_NAME] ;
+    char payload[MAX_BATCH * MAX_MSG_SIZE] ;
+    sMailReqHdr_t req ;
+    sMailRespHdr_t resp ;
+    size_t sent = 0 ;
+
+    pConn->Failed = true ;
+
+    int fd = socket(AF_UNIX , SOCK_STREAM , 0) ;
+
+    memset(&addr , 0 , sizeof(addr));
+    addr.sun_family = AF_UNIX ;
+    strncpy(addr.sun_path , gPath , sizeof(addr.sun_path) - 1);
+
+    if( (fd < 0) || (0 != connect(fd , (struct sockaddr*)&addr , sizeof(addr))) )
+    {
+        perror("mailbox_loadgen");
+        return NULL;
+    }
+
+    /// Open the mailbox of this connection
+    memset(&req , 0 , sizeof(req));
+    req.Op = E_OP_OPEN ;
+    req.Count = (uint16_t)snprintf(name , sizeof(name) , "load%zu" , pConn->Id) ;
+
+    if( (false == LoadWrite(fd , &req , sizeof(req))) || (false == LoadWrite(fd , name , req.Count)) ||
+        (false == LoadRead(fd , &resp , sizeof(resp))) || (E_NOERROR != resp.Status) )
+    {
+        close(fd);
+        return NULL;
+    }
+
+    uint16_t box = resp.Box ;
+    uint64_t* pSent = pConn->Latency ;
+
+    for(size_t done = 0 ; done < gRequests ; done++)
+    {
+        /// Keep the pipeline full
+        while( (sent < gRequests) && (sent - done < gDepth) )
+        {
+            if(false == LoadSend(fd , box , sent , pSent))
+            {
+                close(fd);
+                return NULL;
+            }
+            sent++ ;
+        }
+
+        if( (false == LoadRead(fd , &resp , sizeof(resp))) || (resp.Tag != done) )
+        {
+            close(fd);
+            return NULL;
+        }
+
+        if( (E_OP_RECEIVE == resp.Op) && (false == LoadRead(fd , payload , resp.Count * MAX_MSG_SIZE)) )
+        {
+            close(fd);
+            return NULL;
+        }
+
+        pConn->Latency[done] = MailboxClockNow() - pSent[done] ;
+        pConn->Messages += resp.Count ;
+    }
+
+    close(fd);
+    pConn->Failed = false ;
+
+    return NULL;
+}
+
+/**
+ * @brief qsort compare of latencies
+ */
+static int LoadCompare(const void* a , const void* b)
+{
+    uint64_t x = *(const uint64_t*)a ;
+    uint64_t y = *(const uint64_t*)b ;
+
+    return (x > y) - (x < y) ;
+}
+
+int main(int argc , char** argv)
+{
+    size_t conns = 4 ;
+
+    gPath = (argc > 1) ? argv[1] : gPath ;
+    conns = (argc > 2) ? strtoul(argv[2] , NULL , 0) : conns ;
+    gRequests = (argc > 3) ? strtoul(argv[3] , NULL , 0) : gRequests ;
+    gDepth = (argc > 4) ? strtoul(argv[4] , NULL , 0) : gDepth ;
+    gBatch = (argc > 5) ? strtoul(argv[5] , NULL , 0) : gBatch ;
+
+    if( (0 == conns) || (0 == gRequests) || (0 == gDepth) || (0 == gBatch) || (gBatch > MAX_BATCH) )
+    {
+        fprintf(stderr , "usage: mailbox_loadgen [path] [connections] [requests] [depth] [batch <= %zu]\n" , MAX_BATCH);
+        return 1;
+    }
+
+    sLoadConn_t* pConns = (sLoadConn_t*)calloc(conns , sizeof(sLoadConn_t)) ;
+    uint64_t* pAll = (uint64_t*)malloc(conns * gRequests * sizeof(uint64_t)) ;
+    uint64_t start = MailboxClockNow() ;
+
+    for(size_t i = 0 ; i < conns ; i++)
+    {
+        pConns[i].Id = i ;
+        pConns[i].Latency = &pAll[i * gRequests] ;
+        pthread_create(&pConns[i].Thread , NULL , LoadConn , &pConns[i]);
+    }
+
+    size_t messages = 0 ;
+
+    for(size_t i = 0 ; i < conns ; i++)
+    {
+        pthread_join(pConns[i].Thread , NULL);
+
+        if(true == pConns[i].Failed)
+        {
+            fprintf(stderr , "connection %zu failed\n" , i);
+            return 1;
+        }
+        messages += pConns[i].Messages ;
+    }
+
+    double seconds = (double)(MailboxClockNow() - start) / 1e9 ;
+    size_t total = conns * gRequests ;
+
+    qsort(pAll , total , sizeof(uint64_t) , LoadCompare);
+
+    printf("connections %zu , requests %zu , depth %zu , batch %zu\n" , conns , total , gDepth , gBatch);
+    printf("throughput %.0f req/s , %.0f msg/s\n" , (double)total / seconds , (double)messages / seconds);
+    printf("latency us p50 %.1f p99 %.1f max %.1f\n" , (double)pAll[total / 2] / 1e3 ,
+           (double)pAll[(total * 99) / 100] / 1e3 , (double)pAll[total - 1] / 1e3);
+
+    free(pAll);
+    free(pConns);
+
+    return 0;
+}
@@ -0,0 +1,441 @@
+/**
+ * @file MailBoxServer.c
+ * @author vishal k
+ * @brief Mailbox server, named mailboxes served over a Unix-domain socket, see @ref MailBoxProtocol.h
+ * @date 2021-03-06
+ * 
+ * Usage: mailbox_server [socket path]
+ * 
+ * Single threaded epoll loop. Every readable connection is read until the socket is drained, all complete
+ * requests in the buffer are served and their responses are written back with one write.
+ * 
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "MailBoxProtocol.h"
+#include "MailBoxStatic.h"
+#include "MailBoxDynamic.h"
+#include "UsrConfig.h"
+
+#ifdef USE_STATIC_MAILBOX
+typedef sMailBox_t sServerBox_t;
+#define ServerBoxInit       MailboxStaticInit
+#define ServerBoxAdd        MailboxStaticAddMail
+#define ServerBoxView       MailboxStaticview
+#define ServerBoxDelete     MailboxStaticDeleteMail
+#define ServerBoxScroll     MailboxStaticScrollNext
+#define ServerBoxReceive    MailboxStaticReceive
+#else
+typedef sMailBoxDynamic_t sServerBox_t;
+#define ServerBoxInit       MailboxDynamicInit
+#define ServerBoxAdd        MailboxDynamicAddMail
+#define ServerBoxView       MailboxDynamicview
+#define ServerBoxDelete     MailboxDynamicDeleteMail
+#define ServerBoxScroll     MailboxDynamicScrollNext
+#define ServerBoxReceive    MailboxDynamicReceive
+#endif
+
+static const size_t MAX_SERVER_BOXES = 256 ;        //> Max named mailboxes
+static const size_t MAX_SERVER_EVENTS = 64 ;        //> epoll events handled per wait
+static const size_t CONN_BUF_SIZE = 64 * 1024 ;     //> Input and output buffer of a connection
+
+/**
+ * @brief Named mailbox
+ * 
+ */
+typedef struct
+{
+    char Name[MAX_BOX_NAME + 1];
+    sServerBox_t Box;
+}sServerNamedBox_t;
+
+/**
+ * @brief Client connection
+ * 
+ */
+typedef struct
+{
+    int Fd;
+    size_t InLen;           /**< Bytes received and not served yet*/
+    size_t OutLen;          /**< Bytes of responses not written yet*/
+    bool WantOut;           /**< Registered for EPOLLOUT instead of EPOLLIN because the socket was full*/
+    char In[CONN_BUF_SIZE];
+    char Out[CONN_BUF_SIZE];
+}sServerConn_t;
+
+static sServerNamedBox_t gBoxes[MAX_SERVER_BOXES];   /**< Mailboxes, the index is the id used in requests*/
+static size_t gBoxNum = 0 ;
+
+/**
+ * @brief Find or create a named mailbox
+ * 
+ * @param name name, not terminated
+ * @param len name length
+ * @param pBox will be updated with the mailbox id
+ * @return eMailStatus_t @ref E_MAILBOXFULL if all mailboxes are taken
+ */
+static eMailStatus_t ServerOpen(const char* name , size_t len , uint16_t* pBox)
+{
+    for(size_t i = 0 ; i < gBoxNum ; i++)
+    {
+        if( (len == strlen(gBoxes[i].Name)) && (0 == memcmp(gBoxes[i].Name , name , len)) )
+        {
+            *pBox = (uint16_t)i ;
+            return E_NOERROR;
+        }
+    }
+
+    if(gBoxNum >= MAX_SERVER_BOXES)
+    {
+        return E_MAILBOXFULL;
+    }
+
+    memcpy(gBoxes[gBoxNum].Name , name , len);
+    gBoxes[gBoxNum].Name[len] = '\0' ;
+    ServerBoxInit(&gBoxes[gBoxNum].Box);
+    *pBox = (uint16_t)gBoxNum++ ;
+
+    return E_NOERROR;
+}
+
+/**
+ * @brief Check the header of a request before waiting for its payload
+ * 
+ * @param pReq request header
+ * @return false if the request is malformed
+ */
+static bool ServerReqValid(sMailReqHdr_t const* const pReq)
+{
+    switch(pReq->Op)
+    {
+        case E_OP_OPEN:
+            return (0 != pReq->Count) && (pReq->Count <= MAX_BOX_NAME) ;
+
+        case E_OP_ADD:
+        case E_OP_RECEIVE:
+            return (pReq->Count <= MAX_BATCH) && (pReq->Box < gBoxNum) ;
+
+        case E_OP_VIEW:
+        case E_OP_DELETE:
+        case E_OP_SCROLL:
+            return (pReq->Box < gBoxNum) ;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Payload bytes that follow a request header
+ * 
+ * @param pReq request header
+ * @return size_t payload length
+ */
+static size_t ServerReqPayload(sMailReqHdr_t const* const pReq)
+{
+    if(E_OP_OPEN == pReq->Op)
+    {
+        return pReq->Count ;
+    }
+
+    if(E_OP_ADD == pReq->Op)
+    {
+        return pReq->Count * MAX_MSG_SIZE ;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Serve one valid request and append its response to the output buffer
+ * 
+ * @param pConn connection, must have room for the largest response
+ * @param pReq request header checked with @ref ServerReqValid
+ * @param payload request payload
+ */
+static void ServerServe(sServerConn_t* const pConn , sMailReqHdr_t const* const pReq , const char* payload)
+{
+    sMailRespHdr_t resp ;
+    char* out = &pConn->Out[pConn->OutLen + sizeof(resp)] ;
+    sServerBox_t* pBox = (pReq->Box < gBoxNum) ? &gBoxes[pReq->Box].Box : NULL ;
+    eMailStatus_t status = E_NOERROR ;
+    size_t outLen = 0 ;
+
+    memset(&resp , 0 , sizeof(resp));
+    resp.Op = pReq->Op ;
+    resp.Box = pReq->Box ;
+    resp.Tag = pReq->Tag ;
+
+    switch(pReq->Op)
+    {
+        case E_OP_OPEN:
+            status = ServerOpen(payload , pReq->Count , &resp.Box) ;
+            break;
+
+        case E_OP_ADD:
+            for(size_t i = 0 ; i < pReq->Count ; i++)
+            {
+                eMailStatus_t addStatus = ServerBoxAdd(pBox , &payload[i * MAX_MSG_SIZE]) ;
+
+                if(E_MAILBOXFULL != addStatus)
+                {
+                    resp.Count++ ;
+                }
+
+                if( (E_NOERROR == status) && (E_NOERROR != addStatus) )
+                {
+                    status = addStatus ;
+                }
+            }
+            break;
+
+        case E_OP_VIEW:
+            status = ServerBoxView(pBox , out) ;
+            resp.Count = (E_NOERROR == status) ? 1 : 0 ;
+            outLen = resp.Count * MAX_MSG_SIZE ;
+            break;
+
+        case E_OP_DELETE:
+            status = ServerBoxDelete(pBox) ;
+            break;
+
+        case E_OP_SCROLL:
+            status = ServerBoxScroll(pBox) ;
+            break;
+
+        case E_OP_RECEIVE:
+            while( (resp.Count < pReq->Count) && (E_NOERROR == ServerBoxReceive(pBox , &out[resp.Count * MAX_MSG_SIZE])) )
+            {
+                resp.Count++ ;
+            }
+            status = (0 == resp.Count) ? E_MAILBOXEMPTY : E_NOERROR ;
+            outLen = resp.Count * MAX_MSG_SIZE ;
+            break;
+
+        default:
+            break;
+    }
+
+    resp.Status = (uint8_t)status ;
+    memcpy(&pConn->Out[pConn->OutLen] , &resp , sizeof(resp));
+    pConn->OutLen += sizeof(resp) + outLen ;
+}
+
+/**
+ * @brief Serve every complete request in the input buffer while the output buffer has room
+ * 
+ * @param pConn connection
+ * @return false if a request is malformed
+ */
+static bool ServerServeAll(sServerConn_t* const pConn)
+{
+    size_t pos = 0 ;
+    const size_t maxResp = sizeof(sMailRespHdr_t) + (MAX_BATCH * MAX_MSG_SIZE) ;
+
+    while( (pConn->InLen - pos >= sizeof(sMailReqHdr_t)) && (CONN_BUF_SIZE - pConn->OutLen >= maxResp) )
+    {
+        sMailReqHdr_t req ;
+
+        memcpy(&req , &pConn->In[pos] , sizeof(req));
+
+        if(false == ServerReqValid(&req))
+        {
+            return false;
+        }
+
+        size_t len = sizeof(req) + ServerReqPayload(&req) ;
+
+        if(pConn->InLen - pos < len)
+        {
+            break;
+        }
+
+        ServerServe(pConn , &req , &pConn->In[pos + sizeof(req)]);
+        pos += len ;
+    }
+
+    memmove(pConn->In , &pConn->In[pos] , pConn->InLen - pos);
+    pConn->InLen -= pos ;
+
+    return true;
+}
+
+/**
+ * @brief Write pending responses, watch for EPOLLOUT while the socket is full
+ * 
+ * EPOLLIN is dropped meanwhile, a full input buffer would otherwise report readable on every wait.
+ * 
+ * @param ep epoll descriptor
+ * @param pConn connection
+ * @return false if the connection failed
+ */
+static bool ServerFlush(int ep , sServerConn_t* const pConn)
+{
+    size_t done = 0 ;
+
+    while(done < pConn->OutLen)
+    {
+        ssize_t ret = write(pConn->Fd , &pConn->Out[done] , pConn->OutLen - done) ;
+
+        if(ret < 0)
+        {
+            if(EAGAIN == errno)
+            {
+                break;
+            }
+            return false;
+        }
+        done += (size_t)ret ;
+    }
+
+    memmove(pConn->Out , &pConn->Out[done] , pConn->OutLen - done);
+    pConn->OutLen -= done ;
+
+    bool wantOut = (0 != pConn->OutLen) ;
+
+    if(wantOut != pConn->WantOut)
+    {
+        struct epoll_event ev ;
+
+        ev.events = (uint32_t)(wantOut ? EPOLLOUT : EPOLLIN) ;
+        ev.data.ptr = pConn ;
+        epoll_ctl(ep , EPOLL_CTL_MOD , pConn->Fd , &ev);
+        pConn->WantOut = wantOut ;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Handle an event of a connection
+ * 
+ * @param ep epoll descriptor
+ * @param pConn connection
+ * @return false if the connection is to be closed
+ */
+static bool ServerConnEvent(int ep , sServerConn_t* const pConn)
+{
+    bool open = true ;
+    ssize_t ret = 1 ;
+
+    /// Drain the socket, serving as we go so a full input buffer does not stall the reads
+    while(ret > 0)
+    {
+        size_t inLen = 0 ;
+
+        ret = 0 ;
+
+        /// A full input buffer waits until the responses it is blocked on are written
+        if(pConn->InLen < CONN_BUF_SIZE)
+        {
+            ret = read(pConn->Fd , &pConn->In[pConn->InLen] , CONN_BUF_SIZE - pConn->InLen) ;
+
+            if(ret > 0)
+            {
+                pConn->InLen += (size_t)ret ;
+            }
+            else if( (0 == ret) || (EAGAIN != errno) )
+            {
+                open = false ;
+            }
+        }
+
+        /// Serve and write until the requests are served or the socket is full
+        do
+        {
+            inLen = pConn->InLen ;
+
+            if( (false == ServerServeAll(pConn)) || (false == ServerFlush(ep , pConn)) )
+            {
+                return false;
+            }
+        } while( (inLen != pConn->InLen) && (0 == pConn->OutLen) );
+    }
+
+    return open;
+}
+
+int main(int argc , char** argv)
+{
+    const char* path = (argc > 1) ? argv[1] : MAILBOX_SOCKET_PATH ;
+    struct sockaddr_un addr ;
+    struct epoll_event events[MAX_SERVER_EVENTS] ;
+
+    signal(SIGPIPE , SIG_IGN);
+
+    int lfd = socket(AF_UNIX , SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC , 0) ;
+
+    memset(&addr , 0 , sizeof(addr));
+    addr.sun_family = AF_UNIX ;
+    strncpy(addr.sun_path , path , sizeof(addr.sun_path) - 1);
+    unlink(path);
+
+    if( (lfd < 0) || (0 != bind(lfd , (struct sockaddr*)&addr , sizeof(addr))) || (0 != listen(lfd , 128)) )
+    {
+        perror("mailbox_server");
+        return 1;
+    }
+
+    int ep = epoll_create1(EPOLL_CLOEXEC) ;
+    struct epoll_event lev ;
+
+    lev.events = EPOLLIN ;
+    lev.data.ptr = NULL ;
+    epoll_ctl(ep , EPOLL_CTL_ADD , lfd , &lev);
+
+    printf("mailbox server on %s\n" , path);
+    fflush(stdout);
+
+    for(;;)
+    {
+        int n = epoll_wait(ep , events , MAX_SERVER_EVENTS , -1) ;
+
+        for(int i = 0 ; i < n ; i++)
+        {
+            sServerConn_t* pConn = (sServerConn_t*)events[i].data.ptr ;
+
+            /// Listening socket, accept every pending connection
+            if(NULL == pConn)
+            {
+                int fd = 0 ;
+
+                while( (fd = accept4(lfd , NULL , NULL , SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0 )
+                {
+                    struct epoll_event ev ;
+
+                    pConn = (sServerConn_t*)malloc(sizeof(sServerConn_t)) ;
+
+                    if(NULL == pConn)
+                    {
+                        close(fd);
+                        continue;
+                    }
+                    pConn->Fd = fd ;
+                    pConn->InLen = 0 ;
+                    pConn->OutLen = 0 ;
+                    pConn->WantOut = false ;
+                    ev.events = EPOLLIN ;
+                    ev.data.ptr = pConn ;
+                    epoll_ctl(ep , EPOLL_CTL_ADD , fd , &ev);
+                }
+                continue;
+            }
+
+            if(false == ServerConnEvent(ep , pConn))
+            {
+                close(pConn->Fd);
+                free(pConn);
+            }
+        }
+    }
+
+    return 0;
+}
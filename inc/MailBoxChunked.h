@@ -0,0 +1,54 @@
+/**
+ * @file MailBoxChunked.h
+ * @author vishal k
+ * @brief Header file for the chunked (unrolled list) mail box
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXCHUNKED_H
+#define MAILBOXCHUNKED_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "MailBoxDefines.h"
+
+static const size_t MAIL_CHUNK_MSGS = 8 ;   //> Messages per chunk, at most 255
+
+/**
+ * @brief Block of messages, live messages are Msgs[first] to Msgs[first + count - 1] oldest first
+ * 
+ */
+typedef struct sMailChunk_t
+{
+    struct sMailChunk_t* next;
+    uint8_t first;                              /**< Slot of the oldest message in the chunk*/
+    uint8_t count;                              /**< Live messages in the chunk, never 0 for a linked chunk*/
+    char Msgs[MAIL_CHUNK_MSGS][MAX_MSG_SIZE];
+}sMailChunk_t;
+
+/**
+ * @brief Structure to hold chunked mail box
+ * 
+ */
+typedef struct
+{
+    sMailChunk_t* head;
+    sMailChunk_t* tail;
+    sMailChunk_t* Spare;                        /**< Last released chunk kept to avoid malloc churn at chunk boundaries*/
+    size_t ChunkNum;                            /**< Linked chunks*/
+    size_t CurMsgIndex;
+    size_t ActiveMsgNum;
+}sMailBoxChunked_t;
+
+eMailStatus_t MailboxChunkedInit(sMailBoxChunked_t* const Me);
+eMailStatus_t MailboxChunkedDeinit(sMailBoxChunked_t* const Me);
+eMailStatus_t MailboxChunkedClear(sMailBoxChunked_t* const Me);
+eMailStatus_t MailboxChunkedAddMail(sMailBoxChunked_t* const Me , const char* const msg);
+eMailStatus_t MailboxChunkedview(sMailBoxChunked_t* const Me , char* const msg);
+eMailStatus_t MailboxChunkedScrollNext(sMailBoxChunked_t* const Me);
+eMailStatus_t MailboxChunkedDeleteMail(sMailBoxChunked_t* const Me);
+eMailStatus_t MailboxChunkedReceive(sMailBoxChunked_t* const Me , char* const msg);
+eMailStatus_t MailboxChunkedViewAt(sMailBoxChunked_t* const Me , size_t index , char* const msg);
+
+#endif
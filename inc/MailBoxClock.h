@@ -0,0 +1,15 @@
+/**
+ * @file MailBoxClock.h
+ * @author vishal k
+ * @brief monotonic clock used to timestamp messages
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXCLOCK_H
+#define MAILBOXCLOCK_H
+
+#include <stdint.h>
+
+uint64_t MailboxClockNow();
+
+#endif
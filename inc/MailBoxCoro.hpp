@@ -0,0 +1,198 @@
+/**
+ * @file MailBoxCoro.hpp
+ * @author vishal k
+ * @brief C++20 coroutine receive over the wrapper interface in @ref MailBoxWrapper.h
+ * @date 2021-03-06
+ * @note Needs -std=c++20. The rest of the mailbox does not include this file.
+ * 
+ * co_await on @ref MailboxCoro::receive takes the oldest message if there is one, otherwise the coroutine
+ * is suspended until @ref MailboxCoro::send or @ref MailboxCoro::dispatch hands it a message. The waiting
+ * coroutine is then resumed through the configured @ref MailboxExecutor.
+ * 
+ * Waiters are linked through their awaiter, which lives in the coroutine frame, so suspending and
+ * handing a message to a waiter allocates nothing. A message sent while a coroutine waits goes straight
+ * to that coroutine without passing through mailbox storage.
+ * 
+ */
+#ifndef MAILBOXCORO_HPP
+#define MAILBOXCORO_HPP
+
+#include <array>
+#include <coroutine>
+#include <cstring>
+
+#include "MailBoxWrapper.h"
+
+/**
+ * @brief Message as returned by co_await
+ * 
+ */
+typedef std::array<char , MAX_MSG_SIZE> sMailMsg_t;
+
+/**
+ * @brief Where resumed coroutines run
+ * 
+ */
+class MailboxExecutor
+{
+public:
+    virtual void post(std::coroutine_handle<> handle) = 0;
+
+protected:
+    ~MailboxExecutor() = default;
+};
+
+/**
+ * @brief Executor that resumes the coroutine right away on the thread handing over the message
+ * 
+ */
+class MailboxInlineExecutor final : public MailboxExecutor
+{
+public:
+    void post(std::coroutine_handle<> handle) override
+    {
+        handle.resume();
+    }
+};
+
+/**
+ * @brief Coroutine front end of the mailbox selected in @ref UsrConfig.h
+ * 
+ * Like the wrapper it is not thread safe, send, dispatch and the waiting coroutines share one thread.
+ * A coroutine must not be destroyed while it is suspended in receive.
+ * 
+ */
+class MailboxCoro
+{
+public:
+    /**
+     * @brief Awaiter returned by @ref MailboxCoro::receive
+     * 
+     */
+    class ReceiveAwaiter
+    {
+    public:
+        explicit ReceiveAwaiter(MailboxCoro& box) : Box(box) {}
+
+        /// Take a stored message without suspending if there is one
+        bool await_ready()
+        {
+            return (E_NOERROR == MailboxReceive(Msg.data()));
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            Handle = handle ;
+            Box.Enqueue(this);
+        }
+
+        sMailMsg_t await_resume() const
+        {
+            return Msg;
+        }
+
+    private:
+        friend class MailboxCoro;
+
+        MailboxCoro& Box;
+        sMailMsg_t Msg;
+        std::coroutine_handle<> Handle;
+        ReceiveAwaiter* Next = nullptr;     /**< Next waiter, oldest waiter first*/
+    };
+
+    explicit MailboxCoro(MailboxExecutor& executor) : Executor(executor) {}
+
+    MailboxCoro(const MailboxCoro&) = delete;
+    MailboxCoro& operator=(const MailboxCoro&) = delete;
+
+    /**
+     * @brief co_await the result to get the oldest message
+     * 
+     * @return ReceiveAwaiter awaiter
+     */
+    ReceiveAwaiter receive()
+    {
+        return ReceiveAwaiter(*this);
+    }
+
+    /**
+     * @brief Hand the message to the oldest waiting coroutine, or add it to the mailbox if none waits
+     * 
+     * @param msg message of @ref MAX_MSG_SIZE bytes
+     * @return eMailStatus_t status of @ref MailboxAddMail , @ref E_NOERROR on a direct hand over
+     */
+    eMailStatus_t send(const char* msg)
+    {
+        if(nullptr == Head)
+        {
+            return MailboxAddMail(msg);
+        }
+
+        ReceiveAwaiter* pWaiter = Dequeue() ;
+
+        std::memcpy(pWaiter->Msg.data() , msg , MAX_MSG_SIZE);
+        Executor.post(pWaiter->Handle);
+
+        return E_NOERROR;
+    }
+
+    /**
+     * @brief Hand stored messages to waiting coroutines
+     * 
+     * Call after messages were added through the C interface, e.g. when the descriptor from
+     * @ref MailboxNotifyOpen turns readable
+     * 
+     */
+    void dispatch()
+    {
+        while( (nullptr != Head) && (E_NOERROR == MailboxReceive(Head->Msg.data())) )
+        {
+            Executor.post(Dequeue()->Handle);
+        }
+    }
+
+    /**
+     * @brief Tells if any coroutine waits for a message
+     * 
+     */
+    bool waiting() const
+    {
+        return (nullptr != Head);
+    }
+
+private:
+    void Enqueue(ReceiveAwaiter* pWaiter)
+    {
+        pWaiter->Next = nullptr ;
+
+        if(nullptr == Tail)
+        {
+            Head = pWaiter ;
+        }
+        else
+        {
+            Tail->Next = pWaiter ;
+        }
+        Tail = pWaiter ;
+    }
+
+    ReceiveAwaiter* Dequeue()
+    {
+        ReceiveAwaiter* pWaiter = Head ;
+
+        Head = pWaiter->Next ;
+
+        if(nullptr == Head)
+        {
+            Tail = nullptr ;
+        }
+
+        return pWaiter;
+    }
+
+    MailboxExecutor& Executor;
+    ReceiveAwaiter* Head = nullptr;
+    ReceiveAwaiter* Tail = nullptr;
+};
+
+#endif
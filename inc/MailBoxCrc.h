@@ -0,0 +1,16 @@
+/**
+ * @file MailBoxCrc.h
+ * @author vishal k
+ * @brief CRC32C of message payloads
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXCRC_H
+#define MAILBOXCRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint32_t MailboxCrc32c(const void* const data , size_t len);
+
+#endif
@@ -10,9 +10,15 @@
 #define MAILBOXDEFINES_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 static const size_t MAX_MAILS = 4 ;     //> Max number of messages
 static const size_t MAX_MSG_SIZE = 16 ; //> MAc size of each message
+static const size_t MAX_READERS = 3 ;   //> Max number of named read cursors per mailbox
+static const size_t MAX_READER_NAME = 8 ; //> Max length of a read cursor name including terminator
+static const size_t KEY_TABLE_SIZE = 8 ;  //> Coalescing key table entries, power of two and at least twice MAX_MAILS
+static const size_t MAX_TAGS = 4 ;        //> Number of message tags, messages added without a tag get tag 0
 
 /**
  * @brief enums for holding error types
@@ -22,8 +28,75 @@ typedef enum
 {
     E_NOERROR ,
     E_MAILBOXEMPTY,
-    E_MAILBOXOVERWRITTEN
+    E_MAILBOXOVERWRITTEN,
+    E_MAILBOXFULL,          /**< Message rejected, mailbox full of messages not yet read by all readers or policy @ref E_OVERFLOW_REJECT_NEWEST*/
+    E_READERINVALID,        /**< Reader id is not open or no free reader is available*/
+    E_MAILBOXCOALESCED,     /**< Message replaced the pending message with the same key*/
+    E_MSGTOOLONG,           /**< Fragments add up to more than @ref MAX_MSG_SIZE, nothing was added*/
+    E_NOTIFYUNAVAILABLE,    /**< Readiness descriptor could not be created*/
+    E_MAILBOXTIMEOUT,       /**< Add blocked by @ref E_OVERFLOW_BLOCK gave up, nothing was added*/
+    E_MAILBOXCORRUPT,       /**< Message payload does not match its checksum, it was still copied out*/
+    E_LOGIOERROR            /**< Durable log could not be read, written or synced*/
 }eMailStatus_t;
 
+static const uint64_t MAIL_WAIT_FOREVER = UINT64_MAX ;   //> Timeout of a blocked add without a limit
 
-#endif
\ No newline at end of file
+/**
+ * @brief What happens on add when the mailbox holds @ref MAX_MAILS messages
+ * 
+ */
+typedef enum
+{
+    E_OVERFLOW_DROP_OLDEST,     /**< Overwrite the oldest message and report @ref E_MAILBOXOVERWRITTEN*/
+    E_OVERFLOW_REJECT_NEWEST,   /**< Keep the mailbox as it is and reject the new message with @ref E_MAILBOXFULL*/
+    E_OVERFLOW_BLOCK            /**< Wait for room, @ref E_MAILBOXTIMEOUT if none was made within the timeout*/
+}eMailOverflowPolicy_t;
+
+/**
+ * @brief What happens on add when the oldest message has not been read by every open reader
+ * 
+ */
+typedef enum
+{
+    E_LAP_OVERWRITE,        /**< Overwrite the oldest message, lagging readers skip ahead to the next message*/
+    E_LAP_REJECT            /**< Keep the unread message and reject the new one with @ref E_MAILBOXFULL*/
+}eMailLapPolicy_t;
+
+/**
+ * @brief Named read cursor, consumes the mailbox independently of other readers
+ * 
+ */
+typedef struct
+{
+    bool active;
+    char name[MAX_READER_NAME];
+    uint32_t NextSeq;       /**< Sequence number of the first message not yet passed by this reader*/
+}sMailReader_t;
+
+
+/**
+ * @brief Result of a time range query, walked with the range next function of the mailbox
+ * @note The mailbox must not be changed while the range is being walked
+ * 
+ */
+typedef struct
+{
+    size_t Index;           /**< Logical index of the next message in the range*/
+    size_t End;             /**< Logical index one past the last message in the range*/
+    void* Next;             /**< Next node in the range, used by the dynamic mailbox only*/
+    uint64_t To;            /**< End of the range, used by the dynamic mailbox only*/
+}sMailRange_t;
+
+
+/**
+ * @brief One fragment of a message for scatter/gather add and view, same layout idea as struct iovec
+ * 
+ */
+typedef struct
+{
+    void* Base;             /**< Start of the fragment buffer*/
+    size_t Len;             /**< Bytes in the fragment*/
+}sMailFrag_t;
+
+
+#endif
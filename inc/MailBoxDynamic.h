@@ -13,6 +13,13 @@
 #include <stddef.h>
 #include "UsrConfig.h"
 #include "MailBoxDefines.h"
+#include "MailBoxKeyTable.h"
+#include "MailBoxTimerWheel.h"
+#include "MailBoxSearch.h"
+#include "MailBoxSeqLock.h"
+#include "MailBoxEventFd.h"
+#include "MailBoxOverflow.h"
+#include "MailBoxMemory.h"
 
 /**
  * @brief Struct to hold messages
@@ -21,7 +28,22 @@
 typedef struct sMailNode_t
 {
     char msg[MAX_MSG_SIZE];
+    uint32_t seq;           /**< Mailbox wide sequence number assigned on add, used by readers*/
+    uint64_t timestamp;     /**< @ref MailboxClockNow at add, a coalesced message keeps its first timestamp*/
+    bool keyed;             /**< Message was added with @ref MailboxDynamicAddMailKeyed and is registered in the key table*/
+    uint32_t key;
+    uint32_t gen;           /**< Mailbox generation the node was added in, see @ref MailboxDynamicClear*/
+    bool expired;           /**< Time to live ran out, removed on the next call into the mailbox*/
+    sMailNode_t* ExpiredNext; /**< Next node in @ref sMailBoxDynamic_t::Expired , NULL for the last*/
+    sMailTimer_t Timer;     /**< Expiry timer, running only for messages added with @ref MailboxDynamicAddMailTtl*/
+    uint8_t tag;            /**< Message type, @see MailboxDynamicReceiveTag*/
+    sMailNode_t* TagPrev;   /**< Previous node with the same tag, NULL for the oldest*/
+    sMailNode_t* TagNext;   /**< Next node with the same tag, NULL for the newest*/
+    #ifdef MAILBOX_CHECKSUM
+    uint32_t crc;           /**< CRC32C of the payload, checked when the message is read*/
+    #endif
     sMailNode_t* next;
+    sMailNode_t* prev;      /**< Previous node in the mailbox, lets a node be unlinked without a walk*/
     
 }sMailNode_t;
 
@@ -32,15 +54,62 @@ typedef struct sMailNode_t
 typedef struct 
 {
     sMailNode_t* head;
+    sMailNode_t* tail;
+    sMailNode_t* FreeList;                  /**< Released nodes, reused by add and never freed*/
     uint8_t CurMsgIndex;
     size_t ActiveMsgNum;
+    uint32_t NextSeq;                       /**< Sequence number given to the next added message*/
+    sMailReader_t Readers[MAX_READERS];     /**< Named read cursors @see MailboxDynamicReaderOpen*/
+    eMailLapPolicy_t LapPolicy;
+    sMailKeyTable_t Keys;                   /**< Key to node lookup for coalescing add*/
+    uint32_t Gen;                           /**< Current generation, bumped by @ref MailboxDynamicClear*/
+    sMailTimerWheel_t* Wheel;               /**< Wheel driving message expiry, NULL if not used*/
+    sMailNode_t* Expired;                   /**< Expired nodes not removed yet, chained through @ref sMailNode_t::ExpiredNext*/
+    uint32_t ExpiredNum;                    /**< Messages expired since init*/
+    sMailNode_t* TagHead[MAX_TAGS];         /**< Oldest node of each tag*/
+    sMailNode_t* TagTail[MAX_TAGS];         /**< Newest node of each tag*/
+    sMailSeqLock_t Lock;                    /**< Guards the snapshot functions against the writer*/
+    sMailEventFd_t Notify;                  /**< Readiness descriptor @see MailboxDynamicNotifyOpen*/
+    sMailMemory_t* Memory;                  /**< Provider for new nodes, NULL uses malloc @see MailboxDynamicSetMemory*/
+    sMailOverflow_t Overflow;               /**< Behaviour of add on a full mailbox @see MailboxDynamicSetOverflowPolicy*/
 
 }sMailBoxDynamic_t;
 
 eMailStatus_t MailboxDynamicInit(sMailBoxDynamic_t* const Me);
+eMailStatus_t MailboxDynamicClear(sMailBoxDynamic_t* const Me);
+eMailStatus_t MailboxDynamicDeinit(sMailBoxDynamic_t* const Me);
 eMailStatus_t MailboxDynamicDeleteMail(sMailBoxDynamic_t* const Me );
 eMailStatus_t MailboxDynamicAddMail(sMailBoxDynamic_t* const Me, const char* const msg);
+eMailStatus_t MailboxDynamicAddMailKeyed(sMailBoxDynamic_t* const Me, uint32_t key, const char* const msg);
+eMailStatus_t MailboxDynamicAddMailTtl(sMailBoxDynamic_t* const Me, const char* const msg, uint32_t ttl);
+eMailStatus_t MailboxDynamicAddMailTagged(sMailBoxDynamic_t* const Me, uint8_t tag, const char* const msg);
+eMailStatus_t MailboxDynamicReceiveTag(sMailBoxDynamic_t* const Me , uint8_t tag , char* const msg);
+eMailStatus_t MailboxDynamicDeleteTag(sMailBoxDynamic_t* const Me , uint8_t tag);
+eMailStatus_t MailboxDynamicAddMailGather(sMailBoxDynamic_t* const Me , const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxDynamicviewScatter(sMailBoxDynamic_t* const Me , const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxDynamicSnapshotView(sMailBoxDynamic_t const* const Me , char* const msg);
+eMailStatus_t MailboxDynamicSnapshotAll(sMailBoxDynamic_t const* const Me , char* const msgs , size_t* const pCount);
+eMailStatus_t MailboxDynamicNotifyOpen(sMailBoxDynamic_t* const Me , int* const pFd);
+eMailStatus_t MailboxDynamicNotifyClose(sMailBoxDynamic_t* const Me);
+eMailStatus_t MailboxDynamicReceive(sMailBoxDynamic_t* const Me , char* const msg);
+eMailStatus_t MailboxDynamicScrub(sMailBoxDynamic_t* const Me , size_t* const pCorrupt);
 eMailStatus_t MailboxDynamicScrollNext(sMailBoxDynamic_t* const Me);
 eMailStatus_t MailboxDynamicview(sMailBoxDynamic_t* const Me , char* const msg);
 
+eMailStatus_t MailboxDynamicReaderOpen(sMailBoxDynamic_t* const Me , const char* const name , uint8_t* const pReaderId);
+eMailStatus_t MailboxDynamicReaderClose(sMailBoxDynamic_t* const Me , uint8_t readerId);
+eMailStatus_t MailboxDynamicReaderview(sMailBoxDynamic_t* const Me , uint8_t readerId , char* const msg);
+eMailStatus_t MailboxDynamicReaderScrollNext(sMailBoxDynamic_t* const Me , uint8_t readerId);
+eMailStatus_t MailboxDynamicSetLapPolicy(sMailBoxDynamic_t* const Me , eMailLapPolicy_t policy);
+eMailStatus_t MailboxDynamicSetTimerWheel(sMailBoxDynamic_t* const Me , sMailTimerWheel_t* const pWheel);
+eMailStatus_t MailboxDynamicSetOverflowPolicy(sMailBoxDynamic_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock);
+eMailStatus_t MailboxDynamicSetMemory(sMailBoxDynamic_t* const Me , sMailMemory_t* const pMemory);
+eMailStatus_t MailboxDynamicGetExpired(sMailBoxDynamic_t* const Me , uint32_t* const pCount);
+
+eMailStatus_t MailboxDynamicRangeQuery(sMailBoxDynamic_t* const Me , uint64_t from , uint64_t to , sMailRange_t* const pRange);
+eMailStatus_t MailboxDynamicRangeNext(sMailBoxDynamic_t* const Me , sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp);
+
+eMailStatus_t MailboxDynamicSearch(sMailBoxDynamic_t* const Me , const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound);
+eMailStatus_t MailboxDynamicViewAt(sMailBoxDynamic_t* const Me , size_t index , char* const msg);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+/**
+ * @file MailBoxEventFd.h
+ * @author vishal k
+ * @brief pollable readiness file descriptor of a mailbox
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXEVENTFD_H
+#define MAILBOXEVENTFD_H
+
+#include <stdbool.h>
+
+/**
+ * @brief eventfd that is readable exactly while the mailbox holds messages
+ * 
+ */
+typedef struct
+{
+    int Fd;                 /**< eventfd, -1 while notification is off*/
+    bool Signalled;         /**< Counter of @ref Fd is non zero*/
+}sMailEventFd_t;
+
+void MailboxEventFdInit(sMailEventFd_t* const Me);
+bool MailboxEventFdOpen(sMailEventFd_t* const Me);
+void MailboxEventFdClose(sMailEventFd_t* const Me);
+void MailboxEventFdUpdate(sMailEventFd_t* const Me , bool nonEmpty);
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * @file MailBoxKeyTable.h
+ * @author vishal k
+ * @brief key to message lookup used by coalescing add
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXKEYTABLE_H
+#define MAILBOXKEYTABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MailBoxDefines.h"
+
+/**
+ * @brief Key table entry, free if @ref mail is NULL or @ref gen is not the table generation
+ * 
+ */
+typedef struct
+{
+    uint32_t key;
+    uint32_t gen;
+    void* mail;
+
+}sMailKeyEntry_t;
+
+/**
+ * @brief Open addressing hash table mapping a message key to the message holding it
+ * 
+ */
+typedef struct
+{
+    sMailKeyEntry_t Entries[KEY_TABLE_SIZE];
+    uint32_t Gen;           /**< Bumped by @ref MailboxKeyTableClear*/
+
+}sMailKeyTable_t;
+
+void MailboxKeyTableInit(sMailKeyTable_t* const Me);
+void MailboxKeyTableClear(sMailKeyTable_t* const Me);
+void* MailboxKeyTableFind(sMailKeyTable_t const* const Me , uint32_t key);
+void MailboxKeyTableInsert(sMailKeyTable_t* const Me , uint32_t key , void* const mail);
+void MailboxKeyTableRemove(sMailKeyTable_t* const Me , uint32_t key);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file MailBoxMemory.h
+ * @author vishal k
+ * @brief backing memory provider for large mailbox sets, huge pages and NUMA local placement
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXMEMORY_H
+#define MAILBOXMEMORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const size_t MAIL_HUGE_PAGE_SIZE = 2 * 1024 * 1024 ;    //> Huge page size, regions are multiples of it
+
+/**
+ * @brief Provider options, can be combined
+ * 
+ */
+typedef enum
+{
+    E_MEM_DEFAULT = 0,          /**< Regular pages, default placement*/
+    E_MEM_HUGEPAGE = 1,         /**< Back regions with 2 MB pages, hugetlbfs pages first then transparent huge pages*/
+    E_MEM_NUMA_LOCAL = 2        /**< Prefer the NUMA node of the thread creating the region*/
+}eMailMemFlags_t;
+
+/**
+ * @brief Region header, placed at the start of every mapped region
+ * 
+ */
+typedef struct sMailRegion_t
+{
+    struct sMailRegion_t* next;
+    size_t size;
+}sMailRegion_t;
+
+/**
+ * @brief Bump allocator over large mapped regions
+ * 
+ * Memory is handed out in 64 byte aligned pieces and only given back all at once by
+ * @ref MailboxMemoryDeinit. It suits mailbox structures and dynamic nodes, which are never freed.
+ * One provider belongs to one thread, it is not thread safe.
+ * 
+ */
+typedef struct
+{
+    uint32_t Flags;             /**< @ref eMailMemFlags_t*/
+    size_t RegionSize;          /**< Size of a new region, multiple of @ref MAIL_HUGE_PAGE_SIZE*/
+    sMailRegion_t* Regions;     /**< Mapped regions, newest first*/
+    char* Cur;                  /**< Next free byte of the newest region*/
+    size_t Left;                /**< Free bytes after @ref Cur*/
+    size_t HugeTlbRegions;      /**< Regions backed by hugetlbfs pages*/
+    size_t ThpRegions;          /**< Regions advised for transparent huge pages*/
+    size_t SmallRegions;        /**< Regions on regular pages*/
+    size_t NumaRegions;         /**< Regions bound to the node of their creator*/
+}sMailMemory_t;
+
+void MailboxMemoryInit(sMailMemory_t* const Me , size_t regionSize , uint32_t flags);
+void MailboxMemoryDeinit(sMailMemory_t* const Me);
+void* MailboxMemoryAlloc(sMailMemory_t* const Me , size_t size);
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file MailBoxOverflow.h
+ * @author vishal k
+ * @brief what a mailbox does with a new message while it is full
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXOVERFLOW_H
+#define MAILBOXOVERFLOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "MailBoxDefines.h"
+
+/**
+ * @brief Overflow state of one mailbox
+ * 
+ */
+typedef struct
+{
+    eMailOverflowPolicy_t Policy;
+    uint64_t Timeout;           /**< Longest wait of a blocked add in nanoseconds, @ref MAIL_WAIT_FOREVER for no limit*/
+    pthread_mutex_t* pLock;     /**< Lock held by every caller of the mailbox, released while an add waits*/
+    pthread_cond_t Space;       /**< Signalled when a message leaves a full mailbox or one of its messages expires*/
+    size_t Waiters;             /**< Adds waiting on @ref Space*/
+}sMailOverflow_t;
+
+void MailboxOverflowInit(sMailOverflow_t* const Me);
+void MailboxOverflowDeinit(sMailOverflow_t* const Me);
+void MailboxOverflowSet(sMailOverflow_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock);
+eMailStatus_t MailboxOverflowAdmit(sMailOverflow_t* const Me , const size_t* const pCount , void (*Reclaim)(void* pOwner) , void* pOwner);
+void MailboxOverflowUpdate(sMailOverflow_t* const Me , size_t count);
+void MailboxOverflowWake(sMailOverflow_t* const Me);
+
+#endif
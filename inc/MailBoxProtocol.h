@@ -0,0 +1,78 @@
+/**
+ * @file MailBoxProtocol.h
+ * @author vishal k
+ * @brief binary protocol of the mailbox server on a Unix-domain stream socket
+ * @date 2021-03-06
+ * 
+ * Every request is a @ref sMailReqHdr_t followed by its payload, every response a @ref sMailRespHdr_t
+ * followed by its payload. Fields are in host byte order, the socket never leaves the host. A client
+ * may write many requests before reading, responses come back in request order.
+ * 
+ * | Op              | Request Count / payload                 | Response Count / payload              |
+ * |-----------------|-----------------------------------------|---------------------------------------|
+ * | E_OP_OPEN       | name length / name                      | 0 , Box holds the mailbox id          |
+ * | E_OP_ADD        | messages / Count * @ref MAX_MSG_SIZE    | messages stored / none                |
+ * | E_OP_VIEW       | 0 / none                                | 1 or 0 / current message              |
+ * | E_OP_DELETE     | 0 / none                                | 0 / none                              |
+ * | E_OP_SCROLL     | 0 / none                                | 0 / none                              |
+ * | E_OP_RECEIVE    | max messages / none                     | messages taken / Count * MAX_MSG_SIZE |
+ * 
+ * Status is the @ref eMailStatus_t of the operation, for a batch add the first status that is not
+ * @ref E_NOERROR. Malformed requests close the connection.
+ * 
+ */
+#ifndef MAILBOXPROTOCOL_H
+#define MAILBOXPROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "MailBoxDefines.h"
+
+static const char MAILBOX_SOCKET_PATH[] = "/tmp/mailbox.sock" ;     //> Default server socket
+static const size_t MAX_BATCH = 64 ;                                //> Max messages in one add or receive request
+static const size_t MAX_BOX_NAME = 32 ;                             //> Max mailbox name length
+
+/**
+ * @brief Request and response operations
+ * 
+ */
+typedef enum
+{
+    E_OP_OPEN = 1,          /**< Open a named mailbox, created on first open*/
+    E_OP_ADD,               /**< Add a batch of messages*/
+    E_OP_VIEW,              /**< Current message*/
+    E_OP_DELETE,            /**< Delete the current message*/
+    E_OP_SCROLL,            /**< Scroll to the next message*/
+    E_OP_RECEIVE            /**< Take up to Count oldest messages*/
+}eMailOp_t;
+
+/**
+ * @brief Request header
+ * 
+ */
+typedef struct
+{
+    uint8_t Op;             /**< @ref eMailOp_t*/
+    uint8_t Reserved;
+    uint16_t Box;           /**< Mailbox id from @ref E_OP_OPEN, unused by open*/
+    uint16_t Count;         /**< Meaning depends on @ref Op*/
+    uint16_t Reserved2;
+    uint32_t Tag;           /**< Copied to the response*/
+}sMailReqHdr_t;
+
+/**
+ * @brief Response header
+ * 
+ */
+typedef struct
+{
+    uint8_t Op;             /**< @ref eMailOp_t of the request*/
+    uint8_t Status;         /**< @ref eMailStatus_t*/
+    uint16_t Box;
+    uint16_t Count;         /**< Meaning depends on @ref Op*/
+    uint16_t Reserved;
+    uint32_t Tag;           /**< Tag of the request*/
+}sMailRespHdr_t;
+
+#endif
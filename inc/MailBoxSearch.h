@@ -0,0 +1,28 @@
+/**
+ * @file MailBoxSearch.h
+ * @author vishal k
+ * @brief payload search kernels used by the mailbox search functions
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXSEARCH_H
+#define MAILBOXSEARCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "MailBoxDefines.h"
+
+/**
+ * @brief Where the pattern has to be found in a payload
+ * 
+ */
+typedef enum
+{
+    E_SEARCH_PREFIX,        /**< Payload starts with the pattern, a one byte prefix matches a tag byte*/
+    E_SEARCH_CONTAINS       /**< Pattern found anywhere in the payload*/
+}eMailSearch_t;
+
+void MailboxSearchScan(const char (*payloads)[MAX_MSG_SIZE] , size_t count , const char* const pattern , size_t len , eMailSearch_t mode , bool* const pMatch);
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file MailBoxSeqLock.h
+ * @author vishal k
+ * @brief sequence lock letting many snapshot readers run next to the single writer of a mailbox
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXSEQLOCK_H
+#define MAILBOXSEQLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Sequence lock, odd while the writer is changing the mailbox
+ * 
+ */
+typedef struct
+{
+    uint32_t Seq;           /**< Bumped when the outermost write section starts and ends*/
+    uint32_t Depth;         /**< Nesting of write sections, only touched by the writer*/
+}sMailSeqLock_t;
+
+void MailboxSeqLockInit(sMailSeqLock_t* const Me);
+void MailboxSeqLockWriteBegin(sMailSeqLock_t* const Me);
+void MailboxSeqLockWriteEnd(sMailSeqLock_t* const Me);
+uint32_t MailboxSeqLockReadBegin(sMailSeqLock_t const* const Me);
+bool MailboxSeqLockReadRetry(sMailSeqLock_t const* const Me , uint32_t start);
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file MailBoxShard.h
+ * @author vishal k
+ * @brief sharded mailbox, one sub-mailbox per cpu with work stealing consumers
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXSHARD_H
+#define MAILBOXSHARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "MailBoxDefines.h"
+#include "MailBoxStatic.h"
+#include "MailBoxDynamic.h"
+#include "UsrConfig.h"
+
+static const size_t MAX_SHARDS = 64 ;   //> Max number of sub-mailboxes in a sharded mailbox
+
+/**
+ * @brief One sub-mailbox, padded to its own cache lines so shards do not false share
+ * 
+ */
+typedef struct
+{
+    pthread_mutex_t Lock;
+    size_t Count;                   /**< Messages in the shard, read without the lock to skip empty shards*/
+    #ifdef USE_STATIC_MAILBOX
+    sMailBox_t Box;
+    #else
+    sMailBoxDynamic_t Box;
+    #endif
+}__attribute__((aligned(64))) sMailShard_t;
+
+/**
+ * @brief Sharded mailbox
+ * 
+ * Ordering: messages of one shard are taken oldest first. There is no global order across shards. A producer
+ * that stays on one cpu, or posts with @ref MailboxShardPostTo to a fixed shard, gets its messages taken in
+ * the order it posted them. A producer that migrates between cpus may have its messages taken out of order.
+ * 
+ */
+typedef struct
+{
+    sMailShard_t Shards[MAX_SHARDS];
+    size_t ShardNum;
+}sMailShardBox_t;
+
+eMailStatus_t MailboxShardInit(sMailShardBox_t* const Me , size_t shardNum);
+eMailStatus_t MailboxShardDeinit(sMailShardBox_t* const Me);
+size_t MailboxShardLocal(sMailShardBox_t const* const Me);
+eMailStatus_t MailboxShardPost(sMailShardBox_t* const Me , const char* const msg);
+eMailStatus_t MailboxShardPostTo(sMailShardBox_t* const Me , size_t shard , const char* const msg);
+eMailStatus_t MailboxShardReceive(sMailShardBox_t* const Me , char* const msg);
+eMailStatus_t MailboxShardReceiveFrom(sMailShardBox_t* const Me , size_t home , char* const msg);
+
+#endif
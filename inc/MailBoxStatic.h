@@ -14,7 +14,14 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "UsrConfig.h"
 #include "MailBoxDefines.h"
+#include "MailBoxKeyTable.h"
+#include "MailBoxTimerWheel.h"
+#include "MailBoxSearch.h"
+#include "MailBoxSeqLock.h"
+#include "MailBoxEventFd.h"
+#include "MailBoxOverflow.h"
 
 /**
  * @brief Struct to hold messages
@@ -23,8 +30,21 @@
 typedef struct 
 {
     bool present;
+    uint32_t gen;           /**< Mailbox generation the message was added in, older generations are free slots*/
     int8_t index;
-    char msg[MAX_MSG_SIZE];
+    uint32_t seq;           /**< Mailbox wide sequence number assigned on add, used by readers*/
+    uint64_t timestamp;     /**< @ref MailboxClockNow at add, a coalesced message keeps its first timestamp*/
+    bool keyed;             /**< Message was added with @ref MailboxStaticAddMailKeyed and is registered in the key table*/
+    uint32_t key;
+    bool expired;           /**< Time to live ran out, removed on the next call into the mailbox*/
+    int8_t ExpiredNext;     /**< Next slot in @ref sMailBox_t::ExpiredHead , -1 for the last*/
+    sMailTimer_t Timer;     /**< Expiry timer, running only for messages added with @ref MailboxStaticAddMailTtl*/
+    uint8_t tag;            /**< Message type, @see MailboxStaticReceiveTag*/
+    int8_t TagPrev;         /**< Previous slot with the same tag, -1 for the oldest*/
+    int8_t TagNext;         /**< Next slot with the same tag, -1 for the newest*/
+    #ifdef MAILBOX_CHECKSUM
+    uint32_t crc;           /**< CRC32C of the payload, checked when the message is read*/
+    #endif
 
 }sMail_t;
 
@@ -35,15 +55,60 @@ typedef struct
 typedef struct 
 {
     sMail_t Mails[MAX_MAILS];
+    char Msgs[MAX_MAILS][MAX_MSG_SIZE];     /**< Payload of each slot, kept apart from @ref Mails so searches scan contiguous memory*/
+    int8_t Order[MAX_MAILS];                /**< Real slot of each logical index, oldest message first*/
     uint8_t CurMsgIndex;
     size_t ActiveMsgNum;
+    uint32_t Gen;                           /**< Current generation, bumped by @ref MailboxStaticClear*/
+    uint32_t NextSeq;                       /**< Sequence number given to the next added message*/
+    sMailReader_t Readers[MAX_READERS];     /**< Named read cursors @see MailboxStaticReaderOpen*/
+    eMailLapPolicy_t LapPolicy;
+    sMailKeyTable_t Keys;                   /**< Key to slot lookup for coalescing add*/
+    sMailTimerWheel_t* Wheel;               /**< Wheel driving message expiry, NULL if not used*/
+    int8_t ExpiredHead;                     /**< Expired slots not removed yet, -1 if none*/
+    uint32_t ExpiredNum;                    /**< Messages expired since init*/
+    int8_t TagHead[MAX_TAGS];               /**< Oldest slot of each tag, -1 if none*/
+    int8_t TagTail[MAX_TAGS];               /**< Newest slot of each tag, -1 if none*/
+    sMailSeqLock_t Lock;                    /**< Guards the snapshot functions against the writer*/
+    sMailEventFd_t Notify;                  /**< Readiness descriptor @see MailboxStaticNotifyOpen*/
+    sMailOverflow_t Overflow;               /**< Behaviour of add on a full mailbox @see MailboxStaticSetOverflowPolicy*/
 }sMailBox_t;
 
 eMailStatus_t MailboxStaticInit(sMailBox_t* const Me);
+eMailStatus_t MailboxStaticClear(sMailBox_t* const Me);
+eMailStatus_t MailboxStaticDeinit(sMailBox_t* const Me);
 eMailStatus_t MailboxStaticDeleteMail(sMailBox_t* const Me);
 eMailStatus_t MailboxStaticAddMail(sMailBox_t* const Me , const char* newMsg);
+eMailStatus_t MailboxStaticAddMailKeyed(sMailBox_t* const Me , uint32_t key , const char* newMsg);
+eMailStatus_t MailboxStaticAddMailTtl(sMailBox_t* const Me , const char* newMsg , uint32_t ttl);
+eMailStatus_t MailboxStaticAddMailTagged(sMailBox_t* const Me , uint8_t tag , const char* newMsg);
+eMailStatus_t MailboxStaticReceiveTag(sMailBox_t* const Me , uint8_t tag , char* const msg);
+eMailStatus_t MailboxStaticDeleteTag(sMailBox_t* const Me , uint8_t tag);
+eMailStatus_t MailboxStaticAddMailGather(sMailBox_t* const Me , const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxStaticviewScatter(sMailBox_t* const Me , const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxStaticSnapshotView(sMailBox_t const* const Me , char* const msg);
+eMailStatus_t MailboxStaticSnapshotAll(sMailBox_t const* const Me , char* const msgs , size_t* const pCount);
+eMailStatus_t MailboxStaticNotifyOpen(sMailBox_t* const Me , int* const pFd);
+eMailStatus_t MailboxStaticNotifyClose(sMailBox_t* const Me);
+eMailStatus_t MailboxStaticReceive(sMailBox_t* const Me , char* const msg);
+eMailStatus_t MailboxStaticScrub(sMailBox_t* const Me , size_t* const pCorrupt);
 eMailStatus_t MailboxStaticScrollNext(sMailBox_t* const Me);
 eMailStatus_t MailboxStaticview(sMailBox_t* const Me , char* const msg);
 
+eMailStatus_t MailboxStaticReaderOpen(sMailBox_t* const Me , const char* const name , uint8_t* const pReaderId);
+eMailStatus_t MailboxStaticReaderClose(sMailBox_t* const Me , uint8_t readerId);
+eMailStatus_t MailboxStaticReaderview(sMailBox_t* const Me , uint8_t readerId , char* const msg);
+eMailStatus_t MailboxStaticReaderScrollNext(sMailBox_t* const Me , uint8_t readerId);
+eMailStatus_t MailboxStaticSetLapPolicy(sMailBox_t* const Me , eMailLapPolicy_t policy);
+eMailStatus_t MailboxStaticSetTimerWheel(sMailBox_t* const Me , sMailTimerWheel_t* const pWheel);
+eMailStatus_t MailboxStaticSetOverflowPolicy(sMailBox_t* const Me , eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock);
+eMailStatus_t MailboxStaticGetExpired(sMailBox_t* const Me , uint32_t* const pCount);
+
+eMailStatus_t MailboxStaticRangeQuery(sMailBox_t* const Me , uint64_t from , uint64_t to , sMailRange_t* const pRange);
+eMailStatus_t MailboxStaticRangeNext(sMailBox_t* const Me , sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp);
+
+eMailStatus_t MailboxStaticSearch(sMailBox_t* const Me , const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound);
+eMailStatus_t MailboxStaticViewAt(sMailBox_t* const Me , size_t index , char* const msg);
+
 
 #endif
\ No newline at end of file
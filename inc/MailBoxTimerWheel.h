@@ -0,0 +1,50 @@
+/**
+ * @file MailBoxTimerWheel.h
+ * @author vishal k
+ * @brief hierarchical timer wheel shared by many mailboxes for message time to live
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXTIMERWHEEL_H
+#define MAILBOXTIMERWHEEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const size_t TIMER_WHEEL_BITS = 6 ;                          //> log2 of slots per level
+static const size_t TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS ;     //> Slots per level
+static const size_t TIMER_WHEEL_LEVELS = 4 ;                        //> Levels, timers further out than SLOTS^LEVELS ticks are re-queued
+
+/**
+ * @brief Timer embedded in every message, linked into a wheel slot while running
+ * 
+ */
+typedef struct sMailTimer_t
+{
+    sMailTimer_t* next;
+    sMailTimer_t* prev;
+    uint32_t expiry;                                /**< Wheel tick at which the timer fires*/
+    void* owner;                                    /**< Mailbox holding the message*/
+    void (*Expire)(sMailTimer_t* const pTimer);     /**< Called once the timer has been unlinked from the wheel*/
+
+}sMailTimer_t;
+
+/**
+ * @brief Timer wheel, one wheel can serve any number of mailboxes
+ * 
+ */
+typedef struct
+{
+    sMailTimer_t Slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];     /**< List heads of each slot*/
+    uint32_t Now;                                                   /**< Current tick*/
+    size_t RunningNum;                                              /**< Number of timers linked into the wheel*/
+
+}sMailTimerWheel_t;
+
+void MailboxTimerWheelInit(sMailTimerWheel_t* const Me , uint32_t now);
+void MailboxTimerWheelAdvance(sMailTimerWheel_t* const Me , uint32_t now);
+void MailboxTimerInit(sMailTimer_t* const pTimer , void* const owner , void (*Expire)(sMailTimer_t* const pTimer));
+void MailboxTimerStart(sMailTimerWheel_t* const Me , sMailTimer_t* const pTimer , uint32_t ttl);
+void MailboxTimerStop(sMailTimerWheel_t* const Me , sMailTimer_t* const pTimer);
+
+#endif
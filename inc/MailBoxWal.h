@@ -0,0 +1,100 @@
+/**
+ * @file MailBoxWal.h
+ * @author vishal k
+ * @brief durable mailbox, add and delete operations recorded in an append only log with group commit
+ * @date 2021-03-06
+ * 
+ */
+#ifndef MAILBOXWAL_H
+#define MAILBOXWAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "MailBoxDefines.h"
+#include "MailBoxStatic.h"
+#include "MailBoxDynamic.h"
+#include "UsrConfig.h"
+
+#ifdef USE_STATIC_MAILBOX
+typedef sMailBox_t sMailWalBox_t;
+#else
+typedef sMailBoxDynamic_t sMailWalBox_t;
+#endif
+
+/**
+ * @brief Log record types
+ * 
+ */
+typedef enum
+{
+    E_WAL_ADD = 1,          /**< Message @ref sMailWalRecord_t::Id added with payload @ref sMailWalRecord_t::Msg*/
+    E_WAL_DELETE,           /**< Message @ref sMailWalRecord_t::Id left the mailbox*/
+    E_WAL_CLEAR             /**< Every message left the mailbox*/
+}eMailWalOp_t;
+
+/**
+ * @brief One log record, the same on disk for both backends
+ * 
+ */
+typedef struct
+{
+    uint32_t Crc;           /**< CRC32C of the rest of the record, a torn record at the end of the log fails it*/
+    uint8_t Op;             /**< @ref eMailWalOp_t*/
+    uint8_t Reserved[3];
+    uint64_t Id;            /**< Log wide message id, given on add*/
+    char Msg[MAX_MSG_SIZE];
+}sMailWalRecord_t;
+
+/**
+ * @brief Durable mailbox
+ * 
+ * Every call goes through @ref Lock , which also guards the mailbox. An add, delete, receive or clear returns
+ * once its record is synced. Records of callers arriving while a sync is running or while the leader waits out
+ * @ref MaxDelay are written and synced together.
+ * Only the operations of this module are logged, so the mailbox must not be changed behind its back and
+ * keyed, tagged and time to live adds are not supported.
+ * The mailbox is changed before the record is committed and @ref Lock is released during the sync, so
+ * @ref MailboxWalview may return a message whose add record is not synced yet.
+ * 
+ */
+typedef struct
+{
+    sMailWalBox_t* pBox;
+    int Fd;                         /**< Log file*/
+    char Path[256];                 /**< Log file name, the compacted log is written next to it and renamed over it*/
+    pthread_mutex_t Lock;
+    pthread_cond_t Joined;          /**< Signalled when the pending batch reaches @ref MaxBatch*/
+    pthread_cond_t Synced;          /**< Signalled when @ref SyncedLsn moves or a sync ends*/
+    sMailWalRecord_t* Pending;      /**< Records not written yet*/
+    size_t PendingNum;
+    size_t PendingCap;
+    sMailWalRecord_t* Writing;      /**< Records being written by the leader, swapped with @ref Pending*/
+    size_t WritingCap;
+    uint64_t NextLsn;               /**< Number of records logged since open, the last one has lsn NextLsn - 1*/
+    uint64_t SyncedLsn;             /**< Records with a lower lsn are on disk*/
+    bool Syncing;                   /**< A leader is collecting or writing a batch*/
+    bool Failed;                    /**< Writing the log failed, every further operation fails*/
+    uint64_t MaxDelay;              /**< Longest time in nanoseconds a leader waits for more records before syncing*/
+    size_t MaxBatch;                /**< Records that make the leader sync without waiting out @ref MaxDelay*/
+    size_t CompactAt;               /**< Records in the log file that trigger compaction*/
+    size_t LogRecords;              /**< Records in the log file*/
+    uint64_t NextId;                /**< Id given to the next added message*/
+    uint64_t Ids[MAX_MAILS];        /**< Id of each message in the mailbox, oldest first*/
+    size_t Syncs;                   /**< Syncs since open, for statistics*/
+    size_t CompactFails;            /**< Compactions since open that failed and kept the old log, for statistics*/
+}sMailWal_t;
+
+eMailStatus_t MailboxWalOpen(sMailWal_t* const Me , sMailWalBox_t* const pBox , const char* const path , uint64_t maxDelay , size_t maxBatch , size_t compactAt);
+eMailStatus_t MailboxWalClose(sMailWal_t* const Me);
+eMailStatus_t MailboxWalAddMail(sMailWal_t* const Me , const char* const msg);
+eMailStatus_t MailboxWalDeleteMail(sMailWal_t* const Me);
+eMailStatus_t MailboxWalReceive(sMailWal_t* const Me , char* const msg);
+eMailStatus_t MailboxWalClear(sMailWal_t* const Me);
+eMailStatus_t MailboxWalview(sMailWal_t* const Me , char* const msg);
+eMailStatus_t MailboxWalScrollNext(sMailWal_t* const Me);
+eMailStatus_t MailboxWalCompact(sMailWal_t* const Me);
+
+#endif
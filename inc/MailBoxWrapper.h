@@ -10,15 +10,46 @@
 #ifndef MAILBOXWRAPPER_H
 #define MAILBOXWRAPPER_H
 
+#include <pthread.h>
 #include "MailBoxDefines.h"
+#include "MailBoxTimerWheel.h"
+#include "MailBoxSearch.h"
 
 eMailStatus_t MailboxInit();
+eMailStatus_t MailboxDeinit();
+eMailStatus_t MailboxClear();
 eMailStatus_t MailboxDeleteMail();
 eMailStatus_t MailboxAddMail(const char* msg);
+eMailStatus_t MailboxAddMailKeyed(uint32_t key , const char* msg);
+eMailStatus_t MailboxAddMailTtl(const char* msg , uint32_t ttl);
+eMailStatus_t MailboxAddMailTagged(uint8_t tag , const char* msg);
+eMailStatus_t MailboxReceiveTag(uint8_t tag , char* const msg);
+eMailStatus_t MailboxDeleteTag(uint8_t tag);
+eMailStatus_t MailboxAddMailGather(const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxviewScatter(const sMailFrag_t* const frags , size_t fragNum);
+eMailStatus_t MailboxSnapshotView(char* const msg);
+eMailStatus_t MailboxSnapshotAll(char* const msgs , size_t* const pCount);
+eMailStatus_t MailboxNotifyOpen(int* const pFd);
+eMailStatus_t MailboxNotifyClose();
+eMailStatus_t MailboxReceive(char* const msg);
+eMailStatus_t MailboxScrub(size_t* const pCorrupt);
 eMailStatus_t MailboxScrollNext();
 eMailStatus_t Mailboxview(char* const msg);
 
 eMailStatus_t MailboxViewAll();
 
+eMailStatus_t MailboxReaderOpen(const char* name , uint8_t* const pReaderId);
+eMailStatus_t MailboxReaderClose(uint8_t readerId);
+eMailStatus_t MailboxReaderview(uint8_t readerId , char* const msg);
+eMailStatus_t MailboxReaderScrollNext(uint8_t readerId);
+eMailStatus_t MailboxSetLapPolicy(eMailLapPolicy_t policy);
+eMailStatus_t MailboxSetOverflowPolicy(eMailOverflowPolicy_t policy , uint64_t timeout , pthread_mutex_t* const pLock);
+eMailStatus_t MailboxSetTimerWheel(sMailTimerWheel_t* const pWheel);
+eMailStatus_t MailboxGetExpired(uint32_t* const pCount);
+eMailStatus_t MailboxRangeQuery(uint64_t from , uint64_t to , sMailRange_t* const pRange);
+eMailStatus_t MailboxRangeNext(sMailRange_t* const pRange , char* const msg , uint64_t* const pTimestamp);
+eMailStatus_t MailboxSearch(const char* const pattern , size_t len , eMailSearch_t mode , size_t* const pIndices , size_t maxIndices , size_t* const pFound);
+eMailStatus_t MailboxViewAt(size_t index , char* const msg);
+
 
 #endif
\ No newline at end of file
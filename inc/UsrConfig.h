@@ -12,4 +12,9 @@
 #define USE_STATIC_MAILBOX      //> Enable for using static mail box
 // #define USE_DYNAMIC_MAILBOX  //> Enable for using dynamic mail box
 
+// #define MAILBOX_SECURE_WIPE  //> Enable to zero message payloads on delete and clear
+// #define MAILBOX_CHECKSUM     //> Enable to keep a CRC32C per message, checked when the message is read
+
+#define MAILBOX_CHUNKED_MAX_MAILS 4096  //> Max number of messages of the chunked mail box, see MailBoxChunked.h
+
 #endif
\ No newline at end of file